@@ -0,0 +1,181 @@
+#include "basis.h"
+#include "modular.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+typedef std::vector<std::vector<Rational>> Matrix;
+
+std::string row_name(const Model& m, int i)
+{
+  return i < (int)m.cname.size() ? m.cname[i] : "#" + std::to_string(i);
+}
+
+std::string var_name(const Model& m, int j)
+{
+  return j < (int)m.vname.size() ? m.vname[j] : "#" + std::to_string(j);
+}
+
+} // namespace
+
+Basis basis_of(const std::string& model, const Model& m, const Density_result& r)
+{
+  const Program& lp = m.lp;
+  Basis b;
+  b.model = model;
+  b.rows = lp.get_m();
+  b.columns = lp.get_n();
+  std::vector<Rational> x;
+  for (const Named_value& v : r.values) x.push_back(v.value);
+  for (int j = 0; j < b.columns; ++j) {
+    const bool at_lower = lp.get_fl()[j] && x[j] == Rational(lp.get_l()[j]);
+    const bool at_upper = lp.get_fu()[j] && x[j] == Rational(lp.get_u()[j]);
+    if (!at_lower && at_upper) b.at_upper.push_back(j);
+    else if (!at_lower) b.basic.push_back(j);
+  }
+  for (int i = 0; i < b.rows; ++i) {
+    Rational ax(0);
+    for (int j = 0; j < b.columns; ++j) {
+      const IT a = lp.get_a()[j][i];
+      if (a != 0) ax += Rational(a) * x[j];
+    }
+    if (ax == Rational(lp.get_b()[i])) b.tight.push_back(i);
+  }
+  std::vector<Rational> d(b.columns);
+  for (int j = 0; j < b.columns; ++j) d[j] = Rational(lp.get_c()[j]);
+  for (const Named_value& v : r.multipliers) {
+    if (v.value == 0) continue;
+    b.dual.push_back(v.index);
+    for (int j = 0; j < b.columns; ++j) {
+      const IT a = lp.get_a()[j][v.index];
+      if (a != 0) d[j] += v.value * Rational(a);
+    }
+  }
+  std::vector<bool> is_basic(b.columns, false);
+  for (int j : b.basic) is_basic[j] = true;
+  for (int j = 0; j < b.columns; ++j)
+    if (!is_basic[j] && d[j] == 0) b.reduced.push_back(j);
+  return b;
+}
+
+bool write_basis(const std::string& path, const Model& m, const Basis& b)
+{
+  std::ofstream out(path);
+  if (!out) return false;
+  out << "# optimal basis, see basis.h\n"
+      << "model " << b.model << "\n"
+      << "size " << b.rows << " " << b.columns << "\n";
+  for (int j : b.basic) out << "basic " << j << " " << var_name(m, j) << "\n";
+  for (int j : b.at_upper) out << "upper " << j << " " << var_name(m, j) << "\n";
+  for (int i : b.tight) out << "tight " << i << " " << row_name(m, i) << "\n";
+  for (int i : b.dual) out << "dual " << i << " " << row_name(m, i) << "\n";
+  for (int j : b.reduced) out << "reduced " << j << " " << var_name(m, j) << "\n";
+  return (bool)out;
+}
+
+std::string read_basis(const std::string& path, const Model& m, Basis& b)
+{
+  std::ifstream in(path);
+  if (!in) return "cannot read " + path;
+  b = Basis();
+  const int rows = m.lp.get_m(), cols = m.lp.get_n();
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream ls(line);
+    std::string key;
+    ls >> key;
+    if (key == "model") { ls >> b.model; continue; }
+    if (key == "size") {
+      ls >> b.rows >> b.columns;
+      if (b.rows != rows || b.columns != cols)
+        return "the basis is for " + std::to_string(b.rows) + " rows and " + std::to_string(b.columns)
+               + " columns, the model has " + std::to_string(rows) + " and " + std::to_string(cols);
+      continue;
+    }
+    int k;
+    std::string name;
+    ls >> k;
+    std::getline(ls, name);
+    if (!name.empty() && name[0] == ' ') name.erase(0, 1);
+    const bool var = key == "basic" || key == "upper" || key == "reduced";
+    if (!var && key != "tight" && key != "dual") return "unknown entry " + key;
+    if (k < 0 || k >= (var ? cols : rows) || name != (var ? var_name(m, k) : row_name(m, k)))
+      return key + " " + std::to_string(k) + " \"" + name + "\" does not match the model";
+    (key == "basic" ? b.basic : key == "upper" ? b.at_upper : key == "reduced" ? b.reduced
+     : key == "tight" ? b.tight : b.dual).push_back(k);
+  }
+  if (b.rows != rows || b.columns != cols) return "no size in " + path;
+  return "";
+}
+
+std::string certify_basis(const Model& m, const Basis& b, Density_result& r, int threads)
+{
+  const Program& lp = m.lp;
+  const int cols = lp.get_n();
+  auto a = [&](int i, int j) { return Rational(lp.get_a()[j][i]); };
+  auto solve = [&](const Matrix& s, const std::vector<Rational>& rhs, int k, bool unique, std::vector<Rational>& y) {
+    return threads > 0 ? solve_modular(s, rhs, k, unique, y, threads) : solve_rational(s, rhs, k, unique, y);
+  };
+
+  // nonbasic variables at their bounds
+  std::vector<Rational> x(cols, Rational(0));
+  std::vector<bool> is_basic(cols, false);
+  for (int j : b.basic) is_basic[j] = true;
+  for (int j = 0; j < cols; ++j)
+    if (lp.get_fl()[j]) x[j] = Rational(lp.get_l()[j]);
+  for (int j : b.at_upper) {
+    if (!lp.get_fu()[j]) return var_name(m, j) + " has no upper bound any more";
+    x[j] = Rational(lp.get_u()[j]);
+  }
+
+  // the basic values from the tight rows
+  const int k = (int)b.basic.size();
+  Matrix sys;
+  std::vector<Rational> rhs, y;
+  for (int i : b.tight) {
+    std::vector<Rational> row(k);
+    Rational v(lp.get_b()[i]);
+    for (int j = 0; j < cols; ++j) {
+      if (lp.get_a()[j][i] == 0) continue;
+      if (is_basic[j]) continue;
+      v -= a(i, j) * x[j];
+    }
+    for (int c = 0; c < k; ++c) row[c] = a(i, b.basic[c]);
+    sys.push_back(row);
+    rhs.push_back(v);
+  }
+  if (!solve(sys, rhs, k, true, y)) return "the tight rows no longer determine the basic values";
+  for (int c = 0; c < k; ++c) x[b.basic[c]] = y[c];
+
+  // the multipliers from the columns with reduced cost 0: c_j + sum_i a_ij l_i = 0
+  const int d = (int)b.dual.size();
+  sys.clear();
+  rhs.clear();
+  std::vector<int> zero = b.basic;
+  zero.insert(zero.end(), b.reduced.begin(), b.reduced.end());
+  for (int j : zero) {
+    std::vector<Rational> row(d);
+    for (int c = 0; c < d; ++c) row[c] = a(b.dual[c], j);
+    sys.push_back(row);
+    rhs.push_back(-Rational(lp.get_c()[j]));
+  }
+  std::vector<Rational> l;
+  if (!solve(sys, rhs, d, false, l)) return "the columns with reduced cost 0 no longer have multipliers";
+
+  r = Density_result();
+  r.status = Density_status::optimal;
+  r.rows = lp.get_m();
+  r.columns = cols;
+  r.objective = Rational(lp.get_c0());
+  for (int j = 0; j < cols; ++j) {
+    r.objective += Rational(lp.get_c()[j]) * x[j];
+    r.values.push_back({ j, var_name(m, j), x[j] });
+  }
+  r.bound = -r.objective / Rational(m.factor);
+  for (int c = 0; c < d; ++c)
+    if (l[c] != 0) r.multipliers.push_back({ b.dual[c], row_name(m, b.dual[c]), l[c] });
+  return verify_density(m, r);
+}
@@ -0,0 +1,54 @@
+// Optimal bases on disk, for re-verifying a bound without the simplex method.
+//
+// After a solve, basis_of() records which variables are off their bounds, which
+// rows are tight and which rows carry a multiplier. certify_basis() later rebuilds
+// the solution from that alone: the basic values from the tight rows, the
+// multipliers from the columns with reduced cost 0 (c_j + sum_i a_ij l_i = 0: the
+// basic ones and those degenerate at a bound), both exactly (by elimination over
+// the rationals or multi-modularly, see modular.h), and then checks primal
+// feasibility and the dual bound exactly
+// (verify_density). That certifies the bound with no pivots; if the formulation
+// changed so that the basis no longer fits or is no longer optimal, it says why
+// and the caller solves from scratch.
+//
+// The file is text, one entry per line with index and name, e.g.
+//   model basic
+//   size 37 59
+//   basic 2 #edges
+//   tight 5 E - X leq (15/7) (n - 2)
+//   dual 5 E - X leq (15/7) (n - 2)
+//   reduced 7 c5
+// Names are checked on reading, so a renamed or reordered formulation is refused.
+#ifndef BASIS_H
+#define BASIS_H
+
+#include "density_lp.h"
+
+#include <string>
+#include <vector>
+
+struct Basis {
+  std::string model;
+  int rows = 0, columns = 0;
+  std::vector<int> basic;    // variables strictly between their bounds
+  std::vector<int> at_upper; // other variables at their upper bound (the rest sit at the lower one)
+  std::vector<int> tight;    // rows satisfied with equality
+  std::vector<int> dual;     // rows with a nonzero multiplier
+  std::vector<int> reduced;  // nonbasic variables with reduced cost 0
+};
+
+// the basis of an optimal result of m (solved with values and certificate on)
+Basis basis_of(const std::string& model, const Model& m, const Density_result& r);
+
+bool write_basis(const std::string& path, const Model& m, const Basis& b);
+
+// reads path into b and checks it against m; returns an error message or ""
+std::string read_basis(const std::string& path, const Model& m, Basis& b);
+
+// rebuilds the optimal solution of m from b and verifies it exactly; returns ""
+// with the result in r (0 pivots), or why the basis does not certify m. With
+// threads > 0 the systems are solved multi-modularly (modular.h) on that many
+// threads, otherwise by elimination over the rationals
+std::string certify_basis(const Model& m, const Basis& b, Density_result& r, int threads = 0);
+
+#endif
@@ -0,0 +1,96 @@
+// Implied variable bounds of a formulation (see presolve.h): propagates the rows,
+// prints what they bound and which variables they force to zero, then solves
+// with and without the bounds and compares the results.
+//
+//   bounds [--model basic|extended|no8|full] [--rounds 50] [-v]
+//
+// -v prints the exact bounds of every variable.
+#include "presolve.h"
+#include "lp_solve.h"
+#include "telemetry.h"
+
+#include <iostream>
+
+namespace {
+
+typedef CGAL::Gmpq Q;
+
+Q value_of(const Solution& s)
+{
+  return Q(s.objective_value().numerator(), s.objective_value().denominator());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset = "basic";
+  int rounds = 50;
+  bool verbose = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--rounds" && i + 1 < argc) rounds = std::atoi(argv[++i]);
+    else if (a == "-v") verbose = true;
+    else {
+      std::cerr << "usage: bounds [--model basic|extended|no8|full] [--rounds 50] [-v]\n";
+      return 1;
+    }
+  }
+
+  Telemetry tel("bounds", preset);
+  tel.begin("build");
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  tel.model(m);
+
+  tel.begin("presolve");
+  const Implied_bounds ib = implied_bounds(m, rounds);
+  if (!ib.infeasible.empty()) {
+    std::cout << "infeasible: row \"" << ib.infeasible << "\" cannot be satisfied within the bounds\n";
+    return 1;
+  }
+  const int cols = m.lp.get_n();
+  int bounded = 0;
+  for (int j = 0; j < cols; ++j) bounded += ib.has_upper[j];
+  std::cout << ib.rounds << " rounds: " << bounded << " of " << cols << " variables bounded above, "
+            << ib.fixed.size() << " forced to zero\n";
+  for (int j : ib.fixed) std::cout << "  " << m.vname[j] << " = 0\n";
+  for (int j = 0; j < cols; ++j)
+    if (!ib.has_upper[j]) std::cout << "  " << m.vname[j] << " unbounded\n";
+  if (verbose) {
+    std::cout << "\n";
+    for (int j = 0; j < cols; ++j) {
+      std::cout << "  " << (ib.has_lower[j] ? ib.lower[j] : Q(0)) << " <= " << m.vname[j];
+      if (ib.has_upper[j]) std::cout << " <= " << ib.upper[j];
+      std::cout << "\n";
+    }
+  }
+
+  Model bm;
+  build_model(preset, bm);
+  const int set = apply_bounds(bm, ib);
+  tel.count("bounds_set", set);
+
+  tel.begin("solve");
+  const Solution plain = solve_lp(m.lp);
+  tel.solved(plain);
+  const Solution tight = solve_lp(bm.lp);
+  tel.solved(tight);
+  tel.begin("output");
+  if (!plain.is_optimal() || !tight.is_optimal()) {
+    std::cout << "not optimal (" << (plain.is_optimal() ? "with" : "without") << " the bounds)\n";
+    return 1;
+  }
+  const Q factor(m.factor);
+  std::cout << "\n" << set << " bounds passed to the solver\n"
+            << "without: |E| leq " << -value_of(plain) / factor << "n, " << plain.number_of_iterations() << " pivots\n"
+            << "with:    |E| leq " << -value_of(tight) / factor << "n, " << tight.number_of_iterations() << " pivots\n";
+  if (value_of(plain) != value_of(tight)) {
+    std::cout << "the bounds changed the optimum\n";
+    return 1;
+  }
+}
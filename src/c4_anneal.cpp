@@ -0,0 +1,405 @@
+// Local search for dense C4-free 1-planar graphs at sizes exhaustive generation
+// cannot reach: simulated annealing with a tabu list, run as independent chains
+// on all cores, reporting the best number of edges for each n as it improves.
+//
+//   c4_anneal [-n 1000,4000] [--host file]... [--max-face 8] [--seconds 10]
+//             [--steps 0] [--chains threads] [--tenure 50] [--seed 1]
+//             [-j threads] [--out prefix]
+//
+// The drawings live on a plane host graph: a square grid of about n vertices
+// for each -n, or the plane embeddings (format of embedding.h, no crossings) of
+// --host. An edge of the drawing is either a host edge, drawn where the host has
+// it, or a chord of a host cell with at most --max-face vertices, drawn inside
+// the cell as a straight chord of a convex polygon. Two chords of a cell cross
+// when their ends alternate around it, and the drawing is 1-plane as long as
+// every chord crosses at most one other (host edges are never crossed), so
+// checking a move only looks at the chords of one cell. The 4-cycles are
+// checked by the co-degree structure of c4_dynamic.h.
+//
+// A step picks a random slot (host edge or chord) and
+//   * removes its edge if it has one (accepted with probability exp(-1/T)),
+//   * re-routes the pair to it if the pair is already drawn elsewhere,
+//   * adds the edge if that keeps the drawing 1-plane and C4-free, or else,
+//     if only a 4-cycle is in the way, swaps it for an edge of that cycle.
+// A removed slot is tabu for --tenure steps. T falls geometrically from 2 to
+// 0.02 over the run (--seconds per size, or --steps per chain). Every new best
+// is printed as "n <n> edges <E> E/(n-2) <density> (chain <c>, <s> s)", to
+// compare with the bound of the formulations (e.g. ./lp_solver_extended);
+// --out writes the best drawing of each size to <prefix><n>.txt, which census
+// and c4_complete read. The drawing is only maximal among the slots: c4_complete
+// can often still add edges, and census reports the rows of the formulations
+// that assume a saturated drawing (e.g. #23 of full) as violated.
+#include "c4_dynamic.h"
+#include "embedding.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// the slots of a host: every place an edge can be drawn
+struct Host {
+  std::string name;
+  Embedding plane;
+  std::vector<std::pair<int, int>> ends;   // endpoints of each slot
+  std::vector<int> cell;                   // -1 for a host edge, else the cell of a chord
+  std::vector<std::pair<int, int>> pos;    // positions of a chord on its cell
+  std::vector<std::vector<int>> boundary;  // vertices around each cell, in face order
+  std::vector<std::vector<int>> crosses;   // chords a chord crosses
+  std::vector<std::vector<int>> clash;     // chords it crosses that share an end: never both
+};
+
+std::uint64_t pair_key(int u, int v)
+{
+  if (u > v) std::swap(u, v);
+  return (std::uint64_t)(std::uint32_t)u << 32 | (std::uint32_t)v;
+}
+
+Embedding grid(int n)
+{
+  const int a = std::max(2, (int)std::lround(std::sqrt((double)n)));
+  const int b = std::max(2, (n + a - 1) / a);
+  Embedding g;
+  g.name = "grid " + std::to_string(a) + "x" + std::to_string(b);
+  g.n = a * b;
+  g.rot.assign(g.n, {});
+  // row r is drawn at height -r: right, up, left, down is ccw
+  for (int r = 0; r < a; ++r)
+    for (int c = 0; c < b; ++c) {
+      auto& rot = g.rot[r * b + c];
+      if (c + 1 < b) rot.push_back(r * b + c + 1);
+      if (r > 0) rot.push_back((r - 1) * b + c);
+      if (c > 0) rot.push_back(r * b + c - 1);
+      if (r + 1 < a) rot.push_back((r + 1) * b + c);
+    }
+  return g;
+}
+
+std::string make_host(const Embedding& e, int max_face, Host& h)
+{
+  if (!e.cross.empty()) return "the host must be plane (no crossings)";
+  Planarization p;
+  const std::string err = planarize(e, p);
+  if (!err.empty()) return err;
+  h.name = e.name;
+  h.plane = e;
+  for (int u = 0; u < e.n; ++u)
+    for (int w : e.rot[u])
+      if (u < w) {
+        h.ends.push_back({ u, w });
+        h.cell.push_back(-1);
+        h.pos.push_back({ -1, -1 });
+      }
+  for (int f = 0; f < p.num_faces(); ++f) {
+    std::vector<int> on;
+    int x = p.first[f];
+    do {
+      on.push_back(p.tail[x]);
+      x = p.fnext(x);
+    } while (x != p.first[f]);
+    h.boundary.push_back(on);
+    const int len = (int)on.size();
+    if (len > max_face) continue;
+    const std::size_t first = h.ends.size();
+    for (int i = 0; i < len; ++i)
+      for (int j = i + 2; j < len; ++j) {
+        if ((i == 0 && j == len - 1) || on[i] == on[j]) continue;
+        h.ends.push_back({ on[i], on[j] });
+        h.cell.push_back(f);
+        h.pos.push_back({ i, j });
+      }
+    h.crosses.resize(h.ends.size());
+    h.clash.resize(h.ends.size());
+    for (std::size_t s = first; s < h.ends.size(); ++s)
+      for (std::size_t t = first; t < s; ++t) {
+        const int i = h.pos[s].first, j = h.pos[s].second, k = h.pos[t].first, l = h.pos[t].second;
+        if (!((i < k && k < j && j < l) || (k < i && i < l && l < j))) continue;
+        const auto& a = h.ends[s];
+        const auto& b = h.ends[t];
+        const bool share = a.first == b.first || a.first == b.second || a.second == b.first || a.second == b.second;
+        (share ? h.clash : h.crosses)[s].push_back((int)t);
+        (share ? h.clash : h.crosses)[t].push_back((int)s);
+      }
+  }
+  h.crosses.resize(h.ends.size());
+  h.clash.resize(h.ends.size());
+  return "";
+}
+
+// the drawing with the occupied slots of h, in the format of embedding.h
+Embedding drawing(const Host& h, const std::vector<char>& used)
+{
+  const Embedding& e = h.plane;
+  // chords leaving each corner: the corner of cell f at position i lies ccw
+  // after the previous vertex of the cell, the chords in it are ordered by
+  // decreasing distance along the cell
+  std::map<std::pair<int, int>, std::vector<std::pair<int, int>>> corner; // (v, previous) -> (distance, target)
+  Embedding out;
+  out.name = h.name;
+  out.n = e.n;
+  out.rot.assign(e.n, {});
+  for (std::size_t s = 0; s < h.ends.size(); ++s) {
+    if (!used[s] || h.cell[s] < 0) continue;
+    const std::vector<int>& on = h.boundary[h.cell[s]];
+    const int len = (int)on.size(), i = h.pos[s].first, j = h.pos[s].second;
+    corner[{ on[i], on[(i + len - 1) % len] }].push_back({ j - i, on[j] });
+    corner[{ on[j], on[(j + len - 1) % len] }].push_back({ i - j + len, on[i] });
+    // a crossing: positions i < k < j < l are cw around the cell, so ccw around the crossing they are i l j k
+    for (std::size_t t : h.crosses[s]) {
+      if (t > s || !used[t]) continue;
+      int a = i, c = j, b = h.pos[t].first, d = h.pos[t].second;
+      if (b < a) { std::swap(a, b); std::swap(c, d); }
+      out.cross.push_back({ on[a], on[d], on[c], on[b] });
+    }
+  }
+  std::unordered_set<std::uint64_t> host_used;
+  for (std::size_t s = 0; s < h.ends.size(); ++s)
+    if (used[s] && h.cell[s] < 0) host_used.insert(pair_key(h.ends[s].first, h.ends[s].second));
+  for (int v = 0; v < e.n; ++v)
+    for (int w : e.rot[v]) {
+      if (host_used.count(pair_key(v, w))) out.rot[v].push_back(w);
+      auto it = corner.find({ v, w });
+      if (it == corner.end()) continue;
+      std::sort(it->second.rbegin(), it->second.rend());
+      for (const auto& c : it->second) out.rot[v].push_back(c.second);
+    }
+  return out;
+}
+
+struct Best {
+  std::mutex lock;
+  long long edges = -1;
+  std::vector<char> used;
+};
+
+struct Options {
+  double seconds = 10;
+  long long steps = 0;
+  int tenure = 50;
+};
+
+class Chain {
+public:
+  Chain(const Host& h, unsigned long long seed)
+    : h(h), g(h.plane.n), used(h.ends.size(), 0), crossed(h.ends.size(), 0), tabu(h.ends.size(), 0), rng(seed) {}
+
+  void run(const Options& o, Best& best, int id, std::chrono::steady_clock::time_point t0, std::mutex& print);
+
+private:
+  const Host& h;
+  C4_graph g;
+  std::vector<char> used;
+  std::vector<int> crossed;           // chords an occupied chord crosses
+  std::vector<long long> tabu;        // step until which a slot stays empty
+  std::unordered_map<std::uint64_t, int> slot_of; // drawn pairs
+  std::mt19937_64 rng;
+
+  // can slot s be occupied without breaking 1-planarity?
+  bool fits(int s) const
+  {
+    if (h.cell[s] < 0) return true;
+    for (int t : h.clash[s])
+      if (used[t]) return false;
+    int k = 0;
+    for (int t : h.crosses[s])
+      if (used[t] && (++k > 1 || crossed[t] > 0)) return false;
+    return true;
+  }
+  void occupy(int s)
+  {
+    used[s] = 1;
+    for (int t : h.crosses[s])
+      if (used[t]) { ++crossed[t]; ++crossed[s]; }
+    slot_of[pair_key(h.ends[s].first, h.ends[s].second)] = s;
+  }
+  void vacate(int s)
+  {
+    used[s] = 0;
+    for (int t : h.crosses[s])
+      if (used[t]) { --crossed[t]; --crossed[s]; }
+    slot_of.erase(pair_key(h.ends[s].first, h.ends[s].second));
+  }
+  void drop(int s, long long step, int tenure)
+  {
+    vacate(s);
+    g.remove(h.ends[s].first, h.ends[s].second);
+    tabu[s] = step + tenure;
+  }
+  void put(int s)
+  {
+    occupy(s);
+    g.add(h.ends[s].first, h.ends[s].second);
+  }
+};
+
+void Chain::run(const Options& o, Best& best, int id, std::chrono::steady_clock::time_point t0, std::mutex& print)
+{
+  const int slots = (int)h.ends.size();
+  if (slots == 0) return;
+  std::uniform_int_distribution<int> pick(0, slots - 1);
+  std::uniform_real_distribution<double> coin(0, 1);
+  const double T0 = 2, T1 = 0.02;
+  double remove_p = 0;
+  long long edges = 0, published = -1;
+
+  // hands the drawing to best if it beats it
+  auto publish = [&](double seconds) {
+    std::lock_guard<std::mutex> guard(best.lock);
+    if (edges <= best.edges) return;
+    best.edges = edges;
+    best.used = used;
+    std::lock_guard<std::mutex> out(print);
+    const int n = h.plane.n;
+    std::cout << "n " << n << " edges " << edges << " E/(n-2) " << (double)edges / std::max(1, n - 2)
+              << " (chain " << id << ", " << seconds << " s)" << std::endl;
+  };
+  auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); };
+
+  for (long long step = 0; o.steps <= 0 || step < o.steps; ++step) {
+    if ((step & 1023) == 0) {
+      const double progress = o.steps > 0 ? (double)step / o.steps : elapsed() / o.seconds;
+      if (progress >= 1) break;
+      remove_p = std::exp(-1 / (T0 * std::pow(T1 / T0, progress)));
+      // copying the drawing costs O(slots), so a new best is handed over at most every 256 steps
+      if (edges > published) { publish(elapsed()); published = edges; }
+    }
+    else if (edges > published && (step & 255) == 0) { publish(elapsed()); published = edges; }
+
+    const int s = pick(rng);
+    if (used[s]) {
+      if (coin(rng) < remove_p) { drop(s, step, o.tenure); --edges; }
+      continue;
+    }
+    if (tabu[s] > step || !fits(s)) continue;
+    const int u = h.ends[s].first, v = h.ends[s].second;
+    auto it = slot_of.find(pair_key(u, v));
+    if (it != slot_of.end()) {
+      // the same edge drawn elsewhere: re-route it here
+      vacate(it->second);
+      occupy(s);
+      continue;
+    }
+    int a, b;
+    if (!g.creates_c4(u, v, a, b)) {
+      put(s);
+      ++edges;
+    }
+    else if (coin(rng) < 0.5) {
+      // swap for a random edge of the 4-cycle u-a-b-v (the count stays)
+      const int k = (int)(rng() % 3);
+      const int x = k == 0 ? u : k == 1 ? a : b, y = k == 0 ? a : k == 1 ? b : v;
+      const int r = slot_of.at(pair_key(x, y));
+      const long long kept = tabu[r];
+      drop(r, step, o.tenure);
+      if (!g.creates_c4(u, v) && fits(s)) put(s);
+      else {
+        put(r);
+        tabu[r] = kept;
+      }
+    }
+  }
+
+  // a last greedy pass fills every free slot that still fits
+  for (int s = 0; s < slots; ++s)
+    if (!used[s] && fits(s) && !g.has_edge(h.ends[s].first, h.ends[s].second)
+        && !g.creates_c4(h.ends[s].first, h.ends[s].second)) {
+      put(s);
+      ++edges;
+    }
+  publish(elapsed());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<int> sizes;
+  std::vector<std::string> host_files;
+  int max_face = 8;
+  Options o;
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  int chains = 0;
+  unsigned long long seed = 1;
+  std::string out_prefix;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "-n" && i + 1 < argc) {
+      std::istringstream in(argv[++i]);
+      std::string n;
+      while (std::getline(in, n, ',')) sizes.push_back(std::atoi(n.c_str()));
+    }
+    else if (a == "--host" && i + 1 < argc) host_files.push_back(argv[++i]);
+    else if (a == "--max-face" && i + 1 < argc) max_face = std::atoi(argv[++i]);
+    else if (a == "--seconds" && i + 1 < argc) o.seconds = std::atof(argv[++i]);
+    else if (a == "--steps" && i + 1 < argc) o.steps = std::atoll(argv[++i]);
+    else if (a == "--chains" && i + 1 < argc) chains = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--tenure" && i + 1 < argc) o.tenure = std::max(0, std::atoi(argv[++i]));
+    else if (a == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--out" && i + 1 < argc) out_prefix = argv[++i];
+    else {
+      std::cerr << "usage: c4_anneal [-n 1000,4000] [--host file]... [--max-face 8] [--seconds 10]\n"
+                   "                 [--steps 0] [--chains threads] [--tenure 50] [--seed 1]\n"
+                   "                 [-j threads] [--out prefix]\n";
+      return 1;
+    }
+  }
+  if (sizes.empty() && host_files.empty()) sizes = { 1000 };
+  if (chains == 0) chains = (int)threads;
+
+  std::vector<Embedding> planes;
+  for (int n : sizes) planes.push_back(grid(n));
+  for (const std::string& f : host_files) {
+    std::ifstream in(f);
+    if (!in) { std::cerr << "cannot open " << f << "\n"; return 1; }
+    std::vector<Embedding> part = read_embeddings(in, f);
+    for (Embedding& e : part) planes.push_back(std::move(e));
+  }
+
+  int errors = 0;
+  std::mutex print;
+  for (const Embedding& e : planes) {
+    Host h;
+    const std::string err = e.error.empty() ? make_host(e, max_face, h) : e.error;
+    if (!err.empty()) {
+      std::cout << e.name << ": " << err << "\n";
+      ++errors;
+      continue;
+    }
+    std::cout << "# " << h.name << ": n " << e.n << ", " << h.ends.size() << " slots, "
+              << chains << " chains on " << std::min<int>(threads, chains) << " threads" << std::endl;
+
+    Best best;
+    std::atomic<int> next(0);
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < std::min<int>(threads, chains); ++t)
+      pool.emplace_back([&] {
+        for (int c; (c = next++) < chains; ) {
+          Chain chain(h, seed + c);
+          chain.run(o, best, c, t0, print);
+        }
+      });
+    for (auto& th : pool) th.join();
+
+    std::cout << h.name << ": n " << e.n << ", best " << best.edges << " edges, E/(n-2) "
+              << (double)best.edges / std::max(1, e.n - 2) << "\n";
+    if (!out_prefix.empty() && best.edges >= 0) {
+      const std::string path = out_prefix + std::to_string(e.n) + ".txt";
+      std::ofstream out(path);
+      write_embedding(out, drawing(h, best.used));
+      std::cout << "wrote " << path << "\n";
+    }
+  }
+  return errors == 0 ? 0 : 1;
+}
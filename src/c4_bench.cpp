@@ -0,0 +1,177 @@
+// Benchmark and check of the dynamic C4 structure (c4_dynamic.h) against
+// recomputing the 4-cycles from scratch.
+//
+// For each n it grows a random C4-free graph with n vertices: random pairs are
+// tried until the average degree reaches --degree, and a pair becomes an edge
+// unless adding it creates a 4-cycle. The incremental queries are timed over the
+// whole run; full recomputation (count the 4-cycles of the graph with the pair
+// added) is timed on a sample of the same kind of queries on the final graph.
+// A batch of insertions is then undone with rollback() and timed as well.
+// --check also compares every answer on the sample with the recomputation (and
+// the cycle creates_c4 returns, asked from either end), and
+// count_c4() with a scan on a dense random graph full of 4-cycles; exit code 1
+// on any difference.
+//
+// usage: c4_bench [-n 1000,10000,100000,1000000] [--degree 6] [--sample 20] [--seed 1] [--check]
+#include "c4_dynamic.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+double since(std::chrono::steady_clock::time_point t0)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+std::vector<std::vector<int>> adjacency(const C4_graph& g)
+{
+  std::vector<std::vector<int>> adj(g.vertices());
+  for (int v = 0; v < g.vertices(); ++v) adj[v] = g.neighbours(v);
+  return adj;
+}
+
+// does adding uv create a 4-cycle, recomputed from scratch (before: the 4-cycles of adj)
+bool creates_c4_scan(std::vector<std::vector<int>>& adj, long long before, int u, int v)
+{
+  adj[u].push_back(v);
+  adj[v].push_back(u);
+  const long long after = count_c4_scan(adj);
+  adj[u].pop_back();
+  adj[v].pop_back();
+  return after > before;
+}
+
+// count_c4() and rollback() on a small dense graph with many 4-cycles
+int check_dense(std::mt19937_64& rng)
+{
+  const int n = 60;
+  C4_graph g(n);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  int failures = 0;
+  for (int k = 0; k < 600; ++k) g.add(pick(rng), pick(rng));
+  const long long edges = g.edges(), cycles = g.count_c4();
+  if (cycles != count_c4_scan(adjacency(g))) {
+    std::cout << "FAIL: count_c4 " << cycles << ", scan " << count_c4_scan(adjacency(g)) << "\n";
+    ++failures;
+  }
+  const std::size_t mark = g.mark();
+  for (int k = 0; k < 300; ++k) {
+    const int u = pick(rng), v = pick(rng);
+    if (k % 3 == 0) g.remove(u, v);
+    else g.add(u, v);
+  }
+  if (g.count_c4() != count_c4_scan(adjacency(g))) {
+    std::cout << "FAIL: count_c4 after updates " << g.count_c4() << ", scan " << count_c4_scan(adjacency(g)) << "\n";
+    ++failures;
+  }
+  g.rollback(mark);
+  if (g.edges() != edges || g.count_c4() != cycles || count_c4_scan(adjacency(g)) != cycles) {
+    std::cout << "FAIL: rollback left " << g.edges() << " edges and " << g.count_c4()
+              << " 4-cycles, expected " << edges << " and " << cycles << "\n";
+    ++failures;
+  }
+  return failures;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<int> sizes = { 1000, 10000, 100000, 1000000 };
+  double degree = 6;
+  int sample = 20;
+  unsigned long long seed = 1;
+  bool check = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "-n" && i + 1 < argc) {
+      sizes.clear();
+      std::istringstream in(argv[++i]);
+      std::string s;
+      while (std::getline(in, s, ',')) sizes.push_back(std::atoi(s.c_str()));
+    }
+    else if (a == "--degree" && i + 1 < argc) degree = std::atof(argv[++i]);
+    else if (a == "--sample" && i + 1 < argc) sample = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+    else if (a == "--check") check = true;
+    else {
+      std::cerr << "usage: c4_bench [-n 1000,10000,100000,1000000] [--degree 6] [--sample 20] [--seed 1] [--check]\n";
+      return 1;
+    }
+  }
+
+  std::mt19937_64 rng(seed);
+  int failures = check ? check_dense(rng) : 0;
+  std::cout << "n  edges  tries  incremental us/query  recompute us/query  speedup  rollback us/edge\n";
+  for (int n : sizes) {
+    if (n < 4) continue;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    C4_graph g(n);
+
+    // grow a random C4-free graph, one query per try
+    const long long target = (long long)(degree * n / 2);
+    long long tries = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    while (g.edges() < target && tries < 20 * target) {
+      const int u = pick(rng), v = pick(rng);
+      ++tries;
+      if (u == v || g.has_edge(u, v)) continue;
+      if (!g.creates_c4(u, v)) g.add(u, v);
+    }
+    const double incremental = since(t0) / tries;
+
+    // the same queries answered by recomputation, on a sample (at most ~10 s of it)
+    std::vector<std::vector<int>> adj = adjacency(g);
+    const long long before = count_c4_scan(adj);
+    int answered = 0;
+    double recompute = 0;
+    while (answered < sample && (answered == 0 || recompute < 10)) {
+      const int u = pick(rng), v = pick(rng);
+      if (u == v || g.has_edge(u, v)) continue;
+      t0 = std::chrono::steady_clock::now();
+      const bool scan = creates_c4_scan(adj, before, u, v);
+      recompute += since(t0);
+      ++answered;
+      if (check && scan != g.creates_c4(u, v)) {
+        std::cout << "FAIL: n " << n << ", pair " << u << " " << v << ": creates_c4 " << !scan << ", scan " << scan << "\n";
+        ++failures;
+      }
+      // the form that returns the cycle, from either end: a path u-a-b-v of distinct vertices
+      for (int e = 0; check && e < 2; ++e) {
+        const int x = e == 0 ? u : v, y = e == 0 ? v : u;
+        int a = -1, b = -1;
+        const bool found = g.creates_c4(x, y, a, b);
+        const bool path = found && a != y && b != x && a != b && g.has_edge(x, a) && g.has_edge(a, b) && g.has_edge(b, y);
+        if (found != scan || (found && !path)) {
+          std::cout << "FAIL: n " << n << ", pair " << x << " " << y << ": creates_c4 with the cycle gives "
+                    << found << " " << a << " " << b << ", scan " << scan << "\n";
+          ++failures;
+        }
+      }
+    }
+    recompute /= answered;
+
+    // a batch of insertions undone
+    const std::size_t mark = g.mark();
+    const long long edges = g.edges();
+    for (long long k = 0; k < std::max(1LL, target / 10); ++k) g.add(pick(rng), pick(rng));
+    const long long added = g.edges() - edges;
+    t0 = std::chrono::steady_clock::now();
+    g.rollback(mark);
+    const double rollback = added > 0 ? since(t0) / added : 0;
+    if (check && (g.edges() != edges || g.count_c4() != 0)) {
+      std::cout << "FAIL: n " << n << ": rollback left " << g.edges() << " edges and " << g.count_c4() << " 4-cycles\n";
+      ++failures;
+    }
+
+    std::cout << n << "  " << g.edges() << "  " << tries << "  " << incremental * 1e6 << "  " << recompute * 1e6
+              << "  " << recompute / incremental << "  " << rollback * 1e6 << "\n";
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+// Maximal C4-free completion of 1-plane skeletons: adds as many candidate
+// edges as it can to each input graph without creating a 4-cycle, with the
+// incremental co-degree structure of c4_dynamic.h instead of rescanning the
+// graph after every edge (as c4_finder.cpp does for one fixed graph).
+//
+//   c4_complete [--candidates file] [--starts 1] [--seed 1] [-j threads]
+//               [--batch 4096] [--check] [-v] [embeddings...]
+//
+// The skeletons are read in the format of embedding.h (all its edges, crossing
+// or not, are kept) and must be C4-free. By default the candidates are the
+// chords of the cells of the planarization: every pair of real vertices on a
+// common cell, drawn inside it as a straight chord of a convex polygon, as
+// c4_anneal.cpp draws them. Two chords of a cell cross when their ends
+// alternate around it; a chord is only added if it crosses at most one chord,
+// that chord is not crossed yet and the two share no end, so the completion
+// stays 1-plane (skeleton edges are never crossed by a chord). With
+// --candidates the pairs "u v" of the file, one per line, are the candidates
+// instead; then only the 4-cycles are checked, and the caller chooses pairs
+// that keep the drawing 1-plane. With one start the candidates are added in
+// the given order and the threads check each batch of them (see
+// complete_c4_free); with --starts k the first start keeps that order and the
+// others shuffle it (seeds seed, seed+1, ...), the starts run on the threads
+// and the completion with the most edges is kept. The result is maximal: no
+// remaining candidate can be added. -v prints the added edges; --check
+// recounts the crossings of the chords drawn and the 4-cycles of the result
+// from scratch, exit code 1 if the completion is not 1-plane or not C4-free.
+#include "c4_dynamic.h"
+#include "embedding.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+typedef std::vector<std::pair<int, int>> Pairs;
+
+// the chords of the cells: pairs of real vertices on a common cell that are
+// not edges yet, and which chords of the same cell cross
+struct Chords {
+  Pairs ends;
+  std::vector<std::vector<int>> crosses; // chords a chord crosses
+  std::vector<std::vector<int>> clash;   // chords it crosses that share an end: never both
+};
+
+std::string cell_chords(const Embedding& e, const C4_graph& g, Chords& c)
+{
+  Planarization p;
+  const std::string err = planarize(e, p);
+  if (!err.empty()) return err;
+  for (int f = 0; f < p.num_faces(); ++f) {
+    std::vector<int> on; // every node around the cell, crossings included
+    int x = p.first[f];
+    do {
+      on.push_back(p.tail[x]);
+      x = p.fnext(x);
+    } while (x != p.first[f]);
+    const int len = (int)on.size();
+    const std::size_t first = c.ends.size();
+    std::vector<std::pair<int, int>> pos;
+    for (int i = 0; i < len; ++i)
+      for (int j = i + 2; j < len; ++j) {
+        if ((i == 0 && j == len - 1) || on[i] == on[j] || p.is_crossing(on[i]) || p.is_crossing(on[j])) continue;
+        if (g.has_edge(on[i], on[j])) continue;
+        c.ends.push_back({ std::min(on[i], on[j]), std::max(on[i], on[j]) });
+        pos.push_back({ i, j });
+      }
+    c.crosses.resize(c.ends.size());
+    c.clash.resize(c.ends.size());
+    for (std::size_t s = 0; s < pos.size(); ++s)
+      for (std::size_t t = 0; t < s; ++t) {
+        const int i = pos[s].first, j = pos[s].second, k = pos[t].first, l = pos[t].second;
+        if (!((i < k && k < j && j < l) || (k < i && i < l && l < j))) continue;
+        const auto& a = c.ends[first + s];
+        const auto& b = c.ends[first + t];
+        const bool share = a.first == b.first || a.first == b.second || a.second == b.first || a.second == b.second;
+        (share ? c.clash : c.crosses)[first + s].push_back((int)(first + t));
+        (share ? c.clash : c.crosses)[first + t].push_back((int)(first + s));
+      }
+  }
+  return "";
+}
+
+// the chords drawn so far; a chord can be added if it keeps every chord crossed at most once
+struct Drawing {
+  const Chords* c;
+  std::vector<char> used;
+  std::vector<int> crossed;
+
+  explicit Drawing(const Chords& c) : c(&c), used(c.ends.size(), 0), crossed(c.ends.size(), 0) {}
+
+  bool fits(int s) const
+  {
+    for (int t : c->clash[s])
+      if (used[t]) return false;
+    int k = 0;
+    for (int t : c->crosses[s])
+      if (used[t] && (++k > 1 || crossed[t] > 0)) return false;
+    return true;
+  }
+
+  void add(int s)
+  {
+    used[s] = 1;
+    for (int t : c->crosses[s])
+      if (used[t]) { ++crossed[t]; ++crossed[s]; }
+  }
+};
+
+// the drawn chords recounted from scratch: "" if no chord is crossed twice and
+// no two chords with a common end cross
+std::string check_drawing(const Chords& c, const std::vector<char>& used)
+{
+  for (std::size_t s = 0; s < used.size(); ++s) {
+    if (!used[s]) continue;
+    int k = 0;
+    for (int t : c.crosses[s]) k += used[t];
+    for (int t : c.clash[s])
+      if (used[t]) return "chords " + std::to_string(c.ends[s].first) + "-" + std::to_string(c.ends[s].second) + " and "
+                          + std::to_string(c.ends[t].first) + "-" + std::to_string(c.ends[t].second) + " share an end and cross";
+    if (k > 1)
+      return "chord " + std::to_string(c.ends[s].first) + "-" + std::to_string(c.ends[s].second) + " is crossed "
+             + std::to_string(k) + " times";
+  }
+  return "";
+}
+
+bool read_pairs(const std::string& path, Pairs& out)
+{
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    const std::size_t hash = line.find('#');
+    if (hash != std::string::npos) line.erase(hash);
+    std::istringstream ss(line);
+    int u, v;
+    if (ss >> u >> v) out.push_back({ u, v });
+  }
+  return true;
+}
+
+C4_graph skeleton(const Embedding& e)
+{
+  C4_graph g(e.n);
+  for (int u = 0; u < e.n; ++u)
+    for (int w : e.rot[u])
+      if (w >= 0 && w < e.n) g.add(u, w);
+  return g;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string candidates_file;
+  int starts = 1;
+  unsigned long long seed = 1;
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t batch = 4096;
+  bool verbose = false, check = false;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--candidates" && i + 1 < argc) candidates_file = argv[++i];
+    else if (a == "--starts" && i + 1 < argc) starts = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--batch" && i + 1 < argc) batch = std::max(1, std::atoi(argv[++i]));
+    else if (a == "-v") verbose = true;
+    else if (a == "--check") check = true;
+    else if (!a.empty() && a[0] == '-') {
+      std::cerr << "usage: c4_complete [--candidates file] [--starts 1] [--seed 1] [-j threads]\n"
+                   "                   [--batch 4096] [--check] [-v] [embeddings...]\n";
+      return 1;
+    }
+    else files.push_back(a);
+  }
+
+  std::vector<Embedding> all;
+  if (files.empty()) all = read_embeddings(std::cin, "<stdin>");
+  for (const std::string& f : files) {
+    std::ifstream in(f);
+    if (!in) { std::cerr << "cannot open " << f << "\n"; return 1; }
+    std::vector<Embedding> part = read_embeddings(in, f);
+    for (Embedding& g : part) all.push_back(std::move(g));
+  }
+  Pairs given;
+  if (!candidates_file.empty() && !read_pairs(candidates_file, given)) {
+    std::cerr << "cannot open " << candidates_file << "\n";
+    return 1;
+  }
+
+  int errors = 0;
+  for (const Embedding& e : all) {
+    if (!e.error.empty()) {
+      std::cout << e.name << ": " << e.error << "\n";
+      ++errors;
+      continue;
+    }
+    const C4_graph base = skeleton(e);
+    if (base.count_c4() > 0) {
+      std::cout << e.name << ": the skeleton has " << base.count_c4() << " 4-cycles\n";
+      ++errors;
+      continue;
+    }
+    Pairs cand;
+    Chords chords;
+    const bool drawn = candidates_file.empty();
+    if (drawn) {
+      const std::string err = cell_chords(e, base, chords);
+      if (!err.empty()) {
+        std::cout << e.name << ": " << err << "\n";
+        ++errors;
+        continue;
+      }
+      cand = chords.ends;
+    }
+    else
+      for (const auto& c : given)
+        if (c.first >= 0 && c.first < e.n && c.second >= 0 && c.second < e.n) cand.push_back(c);
+
+    // one start per order; the best completion, the lowest seed on ties
+    long long best = -1;
+    int best_start = 0;
+    Pairs best_added;
+    std::vector<char> best_used;
+    std::mutex lock;
+    std::atomic<int> next(0);
+    auto run = [&](unsigned inner) {
+      for (int k; (k = next++) < starts; ) {
+        std::vector<int> slot(cand.size());
+        for (std::size_t i = 0; i < slot.size(); ++i) slot[i] = (int)i;
+        if (k > 0) {
+          std::mt19937_64 rng(seed + k - 1);
+          std::shuffle(slot.begin(), slot.end(), rng);
+        }
+        Pairs order(slot.size());
+        for (std::size_t i = 0; i < slot.size(); ++i) order[i] = cand[slot[i]];
+        C4_graph g = base;
+        Drawing d(chords);
+        auto admit = [&](std::size_t i) {
+          if (!d.fits(slot[i])) return false;
+          d.add(slot[i]);
+          return true;
+        };
+        const long long added = drawn ? complete_c4_free(g, order, inner, batch, admit)
+                                      : complete_c4_free(g, order, inner, batch);
+        Pairs edges;
+        if (verbose || check) {
+          for (const auto& c : order)
+            if (g.has_edge(c.first, c.second) && !base.has_edge(c.first, c.second)) edges.push_back(c);
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        if (added > best || (added == best && k < best_start)) {
+          best = added;
+          best_start = k;
+          best_added.swap(edges);
+          best_used.swap(d.used);
+        }
+      }
+    };
+    if (starts == 1) run(threads);
+    else {
+      std::vector<std::thread> pool;
+      for (unsigned t = 0; t < std::min<unsigned>(threads, starts); ++t) pool.emplace_back(run, 1u);
+      for (auto& th : pool) th.join();
+    }
+
+    const long long edges = base.edges() + best;
+    std::cout << e.name << ": n " << e.n << ", " << base.edges() << " edges + " << best << " of "
+              << cand.size() << " candidates = " << edges << " edges, density " << (double)edges / std::max(1, e.n);
+    if (starts > 1)
+      std::cout << " (best of " << starts << " starts: "
+                << (best_start == 0 ? std::string("given order") : "seed " + std::to_string(seed + best_start - 1)) << ")";
+    std::cout << "\n";
+    std::sort(best_added.begin(), best_added.end());
+    best_added.erase(std::unique(best_added.begin(), best_added.end()), best_added.end());
+    if (verbose)
+      for (const auto& c : best_added) std::cout << "  + " << c.first << " " << c.second << "\n";
+    if (check) {
+      std::vector<std::vector<int>> adj(e.n);
+      C4_graph g = base;
+      for (const auto& c : best_added) g.add(c.first, c.second);
+      for (int v = 0; v < e.n; ++v) adj[v] = g.neighbours(v);
+      std::string why = count_c4_scan(adj) == 0 ? "" : "the completion has 4-cycles";
+      if (why.empty() && drawn) why = check_drawing(chords, best_used);
+      if (!why.empty()) {
+        std::cout << e.name << ": FAIL, " << why << "\n";
+        ++errors;
+      }
+    }
+  }
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include "c4_dynamic.h"
+
+#include <algorithm>
+#include <thread>
+
+C4_graph::C4_graph(int n) : adj(n) {}
+
+int C4_graph::codegree(int u, int v) const
+{
+  auto it = codeg.find(key(u, v));
+  return it == codeg.end() ? 0 : it->second;
+}
+
+bool C4_graph::creates_c4(int u, int v) const
+{
+  if (adj[u].size() > adj[v].size()) std::swap(u, v);
+  // a 4-cycle u-a-b-v-u: a neighbour a of u with a common neighbour with v
+  // (u itself is not one, uv is not an edge yet)
+  for (int a : adj[u])
+    if (a != v && codegree(a, v) > 0) return true;
+  return false;
+}
+
+bool C4_graph::creates_c4(int u, int v, int& a, int& b) const
+{
+  // from the endpoint of smaller degree, as above; the path is turned back at the end
+  const bool swapped = adj[u].size() > adj[v].size();
+  if (swapped) std::swap(u, v);
+  for (int x : adj[u]) {
+    if (x == v || codegree(x, v) == 0) continue;
+    // the common neighbour, from the shorter list
+    const bool short_x = adj[x].size() <= adj[v].size();
+    for (int y : adj[short_x ? x : v])
+      if (y != u && has_edge(y, short_x ? v : x)) {
+        a = swapped ? y : x;
+        b = swapped ? x : y;
+        return true;
+      }
+  }
+  return false;
+}
+
+void C4_graph::bump(int u, int v, int by)
+{
+  auto it = codeg.emplace(key(u, v), 0).first;
+  if ((it->second += by) == 0) codeg.erase(it);
+}
+
+void C4_graph::link(int u, int v)
+{
+  for (int w : adj[u]) bump(w, v, 1);
+  for (int w : adj[v]) bump(w, u, 1);
+  adj[u].push_back(v);
+  adj[v].push_back(u);
+  edge.insert(key(u, v));
+  ++m;
+}
+
+void C4_graph::unlink(int u, int v)
+{
+  auto drop = [](std::vector<int>& l, int x) {
+    auto it = std::find(l.begin(), l.end(), x);
+    *it = l.back();
+    l.pop_back();
+  };
+  drop(adj[u], v);
+  drop(adj[v], u);
+  edge.erase(key(u, v));
+  --m;
+  for (int w : adj[u]) bump(w, v, -1);
+  for (int w : adj[v]) bump(w, u, -1);
+}
+
+bool C4_graph::add(int u, int v)
+{
+  if (u == v || has_edge(u, v)) return false;
+  link(u, v);
+  journal.push_back({ u, v, true });
+  return true;
+}
+
+bool C4_graph::remove(int u, int v)
+{
+  if (!has_edge(u, v)) return false;
+  unlink(u, v);
+  journal.push_back({ u, v, false });
+  return true;
+}
+
+void C4_graph::rollback(std::size_t to)
+{
+  while (journal.size() > to) {
+    const Op op = journal.back();
+    journal.pop_back();
+    if (op.added) unlink(op.u, op.v);
+    else link(op.u, op.v);
+  }
+}
+
+long long C4_graph::count_c4() const
+{
+  long long twice = 0;
+  for (const auto& e : codeg) twice += (long long)e.second * (e.second - 1) / 2;
+  return twice / 2;
+}
+
+long long count_c4_scan(const std::vector<std::vector<int>>& adj)
+{
+  // co-degrees of all pairs through each middle vertex
+  std::unordered_map<std::uint64_t, int> codeg;
+  for (const std::vector<int>& l : adj)
+    for (std::size_t i = 0; i < l.size(); ++i)
+      for (std::size_t j = i + 1; j < l.size(); ++j) {
+        int a = l[i], b = l[j];
+        if (a > b) std::swap(a, b);
+        ++codeg[(std::uint64_t)(std::uint32_t)a << 32 | (std::uint32_t)b];
+      }
+  long long twice = 0;
+  for (const auto& e : codeg) twice += (long long)e.second * (e.second - 1) / 2;
+  return twice / 2;
+}
+
+long long complete_c4_free(C4_graph& g, const std::vector<std::pair<int, int>>& candidates,
+                           unsigned threads, std::size_t batch, const std::function<bool(std::size_t)>& admit)
+{
+  long long added = 0;
+  batch = std::max<std::size_t>(batch, 1);
+  std::vector<char> open(std::min(batch, candidates.size()));
+  for (std::size_t first = 0; first < candidates.size(); first += batch) {
+    const std::size_t size = std::min(batch, candidates.size() - first);
+
+    // read-only pass over the batch
+    auto filter = [&](std::size_t from, std::size_t to) {
+      for (std::size_t k = from; k < to; ++k) {
+        const int u = candidates[first + k].first, v = candidates[first + k].second;
+        open[k] = u != v && !g.has_edge(u, v) && !g.creates_c4(u, v);
+      }
+    };
+    const unsigned t = (unsigned)std::min<std::size_t>(std::max(threads, 1u), (size + 255) / 256);
+    if (t <= 1) filter(0, size);
+    else {
+      std::vector<std::thread> pool;
+      for (unsigned i = 0; i < t; ++i)
+        pool.emplace_back(filter, size * i / t, size * (i + 1) / t);
+      for (auto& th : pool) th.join();
+    }
+
+    // the edges added earlier in the batch may close a 4-cycle with a survivor
+    for (std::size_t k = 0; k < size; ++k) {
+      if (!open[k]) continue;
+      const int u = candidates[first + k].first, v = candidates[first + k].second;
+      if (!g.has_edge(u, v) && !g.creates_c4(u, v) && (!admit || admit(first + k))) {
+        g.add(u, v);
+        ++added;
+      }
+    }
+  }
+  return added;
+}
@@ -0,0 +1,87 @@
+// Dynamic C4 detection: a graph under edge insertions and deletions that
+// answers "does adding uv create a 4-cycle?" without rescanning the graph.
+//
+// It keeps the co-degree (number of common neighbours) of every pair of
+// vertices that has one, in a hash map keyed by the pair. Adding uv closes a
+// 4-cycle u-v-b-a exactly when some neighbour a of u has a common neighbour
+// with v, so the query looks up co-degree(a, v) for the neighbours a of the
+// endpoint of smaller degree: O(min degree) expected time. Inserting or
+// deleting uv changes the co-degrees of v with N(u) and of u with N(v),
+// O(deg u + deg v). Every change is journaled, and rollback() undoes the
+// changes after a mark in reverse order, for backtracking searches.
+// The graph need not be C4-free; count_c4() counts its 4-cycles from the map.
+#ifndef C4_DYNAMIC_H
+#define C4_DYNAMIC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class C4_graph {
+public:
+  explicit C4_graph(int n = 0);
+
+  int vertices() const { return (int)adj.size(); }
+  long long edges() const { return m; }
+  int degree(int v) const { return (int)adj[v].size(); }
+  const std::vector<int>& neighbours(int v) const { return adj[v]; }
+  bool has_edge(int u, int v) const { return edge.count(key(u, v)) != 0; }
+  int codegree(int u, int v) const;
+
+  // would adding the (absent) edge uv create a 4-cycle? The second form also
+  // returns one such cycle as the path u-a-b-v
+  bool creates_c4(int u, int v) const;
+  bool creates_c4(int u, int v, int& a, int& b) const;
+
+  // both return false (and change nothing) if the edge is already there / not there
+  bool add(int u, int v);
+  bool remove(int u, int v);
+
+  // the journal: mark() now, rollback(mark) undoes everything since
+  std::size_t mark() const { return journal.size(); }
+  void rollback(std::size_t to);
+
+  // number of 4-cycles: sum over pairs of C(co-degree, 2), each cycle seen from both diagonals
+  long long count_c4() const;
+
+private:
+  struct Op { int u, v; bool added; };
+
+  std::vector<std::vector<int>> adj;
+  std::unordered_set<std::uint64_t> edge;
+  std::unordered_map<std::uint64_t, int> codeg; // pairs with co-degree > 0
+  std::vector<Op> journal;
+  long long m = 0;
+
+  static std::uint64_t key(int u, int v)
+  {
+    if (u > v) { const int t = u; u = v; v = t; }
+    return (std::uint64_t)(std::uint32_t)u << 32 | (std::uint32_t)v;
+  }
+  void bump(int u, int v, int by);
+  void link(int u, int v);
+  void unlink(int u, int v);
+};
+
+// adds the candidate pairs to g in order, each unless it would create a 4-cycle
+// (or is a loop or already an edge); returns the number added. The candidates
+// are checked in batches: a batch is first checked against the graph as it is,
+// on up to `threads` threads, and a pair that fails there fails for good (the
+// graph only grows); the survivors are then rechecked and added one at a time.
+// The result is the same as adding them one at a time, for any batch size.
+// admit, if given, is asked in order for every candidate k that would be added
+// and can still veto it (a drawing constraint, say); it must only get stricter
+// as edges are added, and a candidate it accepts is added.
+long long complete_c4_free(C4_graph& g, const std::vector<std::pair<int, int>>& candidates,
+                           unsigned threads = 1, std::size_t batch = 4096,
+                           const std::function<bool(std::size_t)>& admit = nullptr);
+
+// the 4-cycles of a graph given as adjacency lists, recomputed from scratch
+// (co-degrees of all pairs); the reference the dynamic structure is tested against
+long long count_c4_scan(const std::vector<std::vector<int>>& adj);
+
+#endif
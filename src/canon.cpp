@@ -0,0 +1,323 @@
+#include "canon.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+std::uint64_t hash_form(const std::vector<std::uint64_t>& form)
+{
+  std::uint64_t h = 0x243f6a8885a308d3ULL ^ form.size();
+  for (std::uint64_t w : form) {
+    h ^= w + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdULL;
+  }
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  return h ^ (h >> 33);
+}
+
+typedef std::vector<std::vector<int>> Partition;
+
+struct Union_find {
+  std::vector<int> p;
+  explicit Union_find(int n) : p(n) { std::iota(p.begin(), p.end(), 0); }
+  int find(int v) { while (p[v] != v) v = p[v] = p[p[v]]; return v; }
+  void join(int a, int b) { a = find(a); b = find(b); if (a != b) p[std::max(a, b)] = std::min(a, b); }
+};
+
+class Graph_search {
+public:
+  Graph_search(const std::vector<std::vector<int>>& adj, const std::vector<int>& colour)
+    : adj(adj), colour(colour), n((int)adj.size()), words((n + 63) / 64), row(n, std::vector<std::uint64_t>(words, 0))
+  {
+    for (int v = 0; v < n; ++v)
+      for (int w : adj[v]) row[v][w / 64] |= 1ULL << (w % 64);
+  }
+
+  Canon run()
+  {
+    // the first partition: the colours, in increasing order
+    std::vector<int> by(n);
+    std::iota(by.begin(), by.end(), 0);
+    std::stable_sort(by.begin(), by.end(), [&](int a, int b) { return colour[a] < colour[b]; });
+    Partition cells;
+    for (int k = 0; k < n; ++k) {
+      if (k == 0 || colour[by[k]] != colour[by[k - 1]]) cells.emplace_back();
+      cells.back().push_back(by[k]);
+    }
+    std::vector<int> prefix;
+    search(cells, prefix);
+    Canon c;
+    c.form = best;
+    c.label = best_label;
+    c.hash = hash_form(best);
+    c.nodes = nodes;
+    return c;
+  }
+
+private:
+  const std::vector<std::vector<int>>& adj;
+  const std::vector<int>& colour;
+  int n, words;
+  std::vector<std::vector<std::uint64_t>> row;
+  std::vector<std::uint64_t> best;
+  std::vector<int> best_label, best_vertex;
+  std::vector<std::vector<int>> generators;
+  long long nodes = 0;
+
+  // splits every cell by the number of neighbours of its vertices in each cell,
+  // until nothing splits; the order of the new cells only depends on the old ones
+  void refine(Partition& cells) const
+  {
+    std::vector<int> idx(n), flat, from(n + 1), by;
+    for (;;) {
+      for (std::size_t c = 0; c < cells.size(); ++c)
+        for (int v : cells[c]) idx[v] = (int)c;
+      // the sorted cells of the neighbours of each vertex, one after the other
+      flat.clear();
+      for (int v = 0; v < n; ++v) {
+        from[v] = (int)flat.size();
+        for (int w : adj[v]) flat.push_back(idx[w]);
+        std::sort(flat.begin() + from[v], flat.end());
+      }
+      from[n] = (int)flat.size();
+      auto less = [&](int a, int b) {
+        return std::lexicographical_compare(flat.begin() + from[a], flat.begin() + from[a + 1],
+                                            flat.begin() + from[b], flat.begin() + from[b + 1]);
+      };
+      Partition next;
+      next.reserve(cells.size());
+      for (const std::vector<int>& cell : cells) {
+        if (cell.size() == 1) { next.push_back(cell); continue; }
+        by = cell;
+        std::sort(by.begin(), by.end(), [&](int a, int b) { return less(a, b) || (!less(b, a) && a < b); });
+        for (std::size_t k = 0; k < by.size(); ++k) {
+          if (k == 0 || less(by[k - 1], by[k])) next.emplace_back();
+          next.back().push_back(by[k]);
+        }
+      }
+      const bool split = next.size() != cells.size();
+      cells.swap(next);
+      if (!split) return;
+    }
+  }
+
+  void leaf(const Partition& cells)
+  {
+    std::vector<int> label(n), vertex(n);
+    for (int k = 0; k < n; ++k) {
+      label[cells[k][0]] = k;
+      vertex[k] = cells[k][0];
+    }
+    // colours in label order, then the upper triangle of the adjacency matrix
+    std::vector<std::uint64_t> form;
+    form.reserve(1 + n + (std::size_t)n * words);
+    form.push_back((std::uint64_t)n);
+    for (int k = 0; k < n; ++k) form.push_back((std::uint64_t)(std::int64_t)colour[vertex[k]]);
+    for (int k = 0; k < n; ++k) {
+      std::vector<std::uint64_t> r(words, 0);
+      for (int w : adj[vertex[k]])
+        if (label[w] > k) r[label[w] / 64] |= 1ULL << (label[w] % 64);
+      form.insert(form.end(), r.begin(), r.end());
+    }
+    if (best.empty() || form < best) {
+      best.swap(form);
+      best_label.swap(label);
+      best_vertex.swap(vertex);
+    }
+    else if (form == best) {
+      // an automorphism: this leaf's vertex k goes where the best leaf has it
+      std::vector<int> g(n);
+      bool identity = true;
+      for (int v = 0; v < n; ++v) {
+        g[v] = best_vertex[label[v]];
+        identity &= g[v] == v;
+      }
+      if (!identity) generators.push_back(g);
+    }
+  }
+
+  void search(Partition cells, std::vector<int>& prefix)
+  {
+    ++nodes;
+    refine(cells);
+    std::size_t target = 0;
+    while (target < cells.size() && cells[target].size() == 1) ++target;
+    if (target == cells.size()) {
+      leaf(cells);
+      return;
+    }
+    const std::vector<int> choices = cells[target];
+    std::vector<int> done;
+    for (int w : choices) {
+      // skip w if an automorphism fixing the prefix maps a done child onto it
+      if (!done.empty() && !generators.empty()) {
+        Union_find orbit(n);
+        for (const std::vector<int>& g : generators) {
+          bool fixes = true;
+          for (int v : prefix) fixes &= g[v] == v;
+          if (fixes)
+            for (int v = 0; v < n; ++v) orbit.join(v, g[v]);
+        }
+        bool seen = false;
+        for (int d : done) seen |= orbit.find(d) == orbit.find(w);
+        if (seen) continue;
+      }
+      Partition child;
+      child.reserve(cells.size() + 1);
+      for (std::size_t c = 0; c < cells.size(); ++c) {
+        if (c != target) { child.push_back(cells[c]); continue; }
+        child.push_back({ w });
+        child.emplace_back();
+        for (int v : cells[c])
+          if (v != w) child.back().push_back(v);
+      }
+      prefix.push_back(w);
+      search(std::move(child), prefix);
+      prefix.pop_back();
+      done.push_back(w);
+    }
+  }
+};
+
+// codes of the component of a dart: the walk numbers the nodes in the order it
+// reaches them and records, for each node, its kind and degree and then the
+// numbers of its neighbours in rotation order from the dart it came in on
+struct Dart_walk {
+  const Planarization& p;
+  std::vector<int> num, entry, order;
+  std::vector<std::uint64_t> code;
+
+  explicit Dart_walk(const Planarization& p) : p(p), num(p.nodes, -1), entry(p.nodes, -1) {}
+
+  // walks from h0 along next; true if the code is smaller than best (then it is
+  // in code and the nodes in order), false as soon as it cannot be
+  bool smaller(int h0, const std::vector<int>& next, const std::vector<std::uint64_t>& best)
+  {
+    code.clear();
+    order.clear();
+    int cmp = best.empty() ? -1 : 0;
+    bool stop = false;
+    auto put = [&](std::uint64_t w) {
+      if (cmp == 0) {
+        const std::uint64_t b = code.size() < best.size() ? best[code.size()] : 0;
+        if (w > b) stop = true;
+        else if (w < b) cmp = -1;
+      }
+      code.push_back(w);
+    };
+    auto visit = [&](int x, int d) {
+      num[x] = (int)order.size();
+      entry[x] = d;
+      order.push_back(x);
+    };
+    visit(p.tail[h0], h0);
+    for (std::size_t k = 0; k < order.size() && !stop; ++k) {
+      const int x = order[k], e = entry[x];
+      int deg = 0;
+      for (int d = e;; ) { ++deg; if ((d = next[d]) == e) break; }
+      put((std::uint64_t)p.is_crossing(x) << 32 | (std::uint64_t)deg);
+      for (int d = e; !stop; ) {
+        const int y = p.head(d);
+        if (num[y] < 0) visit(y, d ^ 1);
+        put((std::uint64_t)num[y]);
+        if ((d = next[d]) == e) break;
+      }
+    }
+    for (int x : order) num[x] = -1;
+    return !stop && cmp < 0;
+  }
+};
+
+} // namespace
+
+Canon canonical_graph(const std::vector<std::vector<int>>& adj, const std::vector<int>& colour)
+{
+  const std::vector<int> none(adj.size(), 0);
+  Graph_search s(adj, colour.size() == adj.size() ? colour : none);
+  return s.run();
+}
+
+std::string canonical_embedding(const Embedding& e, Canon& c, bool mirror)
+{
+  Planarization p;
+  const std::string err = planarize(e, p);
+  if (!err.empty()) return err;
+  const int darts = (int)p.tail.size();
+  std::vector<int> rprev(darts);
+  for (int h = 0; h < darts; ++h) rprev[p.rnext[h]] = h;
+
+  // components, each with its smallest code over all starting darts (and directions)
+  std::vector<int> comp(p.nodes, -1);
+  struct Part { std::vector<std::uint64_t> code; std::vector<int> order; };
+  std::vector<Part> parts;
+  Dart_walk walk(p);
+  c = Canon();
+  for (int x = 0; x < p.nodes; ++x) {
+    if (comp[x] >= 0) continue;
+    Part best;
+    if (p.out[x] < 0) {
+      comp[x] = (int)parts.size();
+      best.code = { (std::uint64_t)p.is_crossing(x) << 32 };
+      best.order = { x };
+      parts.push_back(best);
+      continue;
+    }
+    std::vector<int> darts_of;
+    walk.smaller(p.out[x], p.rnext, best.code);
+    const std::vector<int> order = walk.order;
+    best.code.clear();
+    for (int y : order) {
+      comp[y] = (int)parts.size();
+      for (int d = p.out[y];; ) { darts_of.push_back(d); if ((d = p.rnext[d]) == p.out[y]) break; }
+    }
+    for (int dir = 0; dir < (mirror ? 2 : 1); ++dir)
+      for (int h : darts_of) {
+        ++c.nodes;
+        if (walk.smaller(h, dir ? rprev : p.rnext, best.code)) {
+          best.code = walk.code;
+          best.order = walk.order;
+        }
+      }
+    parts.push_back(std::move(best));
+  }
+  std::sort(parts.begin(), parts.end(), [](const Part& a, const Part& b) {
+    return a.code.size() != b.code.size() ? a.code.size() < b.code.size() : a.code < b.code;
+  });
+
+  c.form.push_back((std::uint64_t)e.n);
+  c.label.assign(e.n, -1);
+  int next_label = 0;
+  for (const Part& part : parts) {
+    c.form.push_back(part.code.size());
+    c.form.insert(c.form.end(), part.code.begin(), part.code.end());
+    for (int x : part.order)
+      if (!p.is_crossing(x)) c.label[x] = next_label++;
+  }
+  c.hash = hash_form(c.form);
+  return "";
+}
+
+Canon_set::Canon_set(int shards) : shard(std::max(1, shards)), count(0) {}
+
+bool Canon_set::insert(const Canon& c, long long* id)
+{
+  Shard& s = shard[c.hash % shard.size()];
+  std::lock_guard<std::mutex> guard(s.lock);
+  auto range = s.forms.equal_range(c.hash);
+  for (auto it = range.first; it != range.second; ++it)
+    if (it->second.first == c.form) {
+      if (id) *id = it->second.second;
+      return false;
+    }
+  const long long k = count++;
+  s.forms.emplace(c.hash, std::make_pair(c.form, k));
+  if (id) *id = k;
+  return true;
+}
+
+long long Canon_set::size() const
+{
+  return count;
+}
@@ -0,0 +1,72 @@
+// Canonical labeling of small graphs and 1-plane embeddings, and a set that
+// keeps one graph per isomorphism class, for removing the isomorphic duplicates
+// that generation and enumeration produce (no nauty needed).
+//
+// Graphs are labeled by individualization and refinement: the vertices are
+// split by colour and refined to an equitable partition (vertices in a cell
+// have the same number of neighbours in every cell), then the search
+// individualizes each vertex of the first non-singleton cell in turn, down to
+// discrete partitions. The canonical form is the smallest adjacency matrix over
+// those leaves. Automorphisms found on the way (two leaves with the same matrix)
+// prune the children in the same orbit. This is fast for the graphs here, up
+// to a few hundred vertices, but not meant for hard highly regular families.
+//
+// Embeddings are labeled by their darts instead: starting from each dart, a
+// breadth-first walk that reads every rotation from the dart it arrived on
+// numbers the nodes of the planarization (crossings included), and the smallest
+// code of all starts is canonical. With mirror, the walks in clockwise order are
+// included, so an embedding and its reflection get the same form. This takes
+// O(E^2) time and needs no search.
+//
+// Equal forms mean isomorphic graphs (embeddings); the 64-bit hash of the form
+// picks the shard and bucket of a Canon_set, which compares the full forms, so
+// a hash collision never merges two classes.
+#ifndef CANON_H
+#define CANON_H
+
+#include "embedding.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Canon {
+  std::vector<int> label;            // canonical number of each vertex
+  std::vector<std::uint64_t> form;   // equal forms <=> isomorphic
+  std::uint64_t hash = 0;            // hash of form
+  long long nodes = 0;               // search nodes (graphs) or starting darts (embeddings)
+};
+
+// adj: neighbour lists of a simple undirected graph; colour (optional): vertices
+// of different colours are never mapped onto each other
+Canon canonical_graph(const std::vector<std::vector<int>>& adj, const std::vector<int>& colour = {});
+
+// the planarization of e, as in embedding.h; returns an empty string or why e
+// cannot be planarized
+std::string canonical_embedding(const Embedding& e, Canon& c, bool mirror = true);
+
+// a set of canonical forms that many threads can insert into at once
+class Canon_set {
+public:
+  explicit Canon_set(int shards = 64);
+  Canon_set(const Canon_set&) = delete;
+  Canon_set& operator=(const Canon_set&) = delete;
+
+  // true if c's class was not in the set yet; id (optional) is set to the
+  // index of the first insertion of the class
+  bool insert(const Canon& c, long long* id = nullptr);
+  long long size() const;
+
+private:
+  struct Shard {
+    mutable std::mutex lock;
+    std::unordered_multimap<std::uint64_t, std::pair<std::vector<std::uint64_t>, long long>> forms;
+  };
+  std::vector<Shard> shard;
+  std::atomic<long long> count;
+};
+
+#endif
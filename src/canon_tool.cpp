@@ -0,0 +1,204 @@
+// Removes isomorphic duplicates from files of embeddings with the canonical
+// forms of canon.h, on several threads sharing one Canon_set.
+//
+//   canon [--graph] [--no-mirror] [-j threads] [--write file] [-v] [embeddings...]
+//   canon --check k [embeddings...]
+//
+// By default two embeddings are the same if some relabeling and possibly a
+// reflection (not with --no-mirror) maps one onto the other, rotations and
+// crossings included; --graph compares only the graphs. It prints the number of
+// inputs and of classes and the time per input; -v names the input each
+// duplicate repeats, --write writes the first embedding of every class.
+// --check k relabels every input (and with it, the reflection and rotated
+// rotation lists) k times at random and checks the form does not change; it
+// also checks canonical_graph the same way on random graphs and counts the
+// graphs on 6 vertices up to isomorphism (156). Exit code 1 on a failure.
+#include "canon.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace {
+
+std::vector<std::vector<int>> graph_of(const Embedding& e)
+{
+  std::vector<std::vector<int>> adj(e.n);
+  for (int v = 0; v < e.n; ++v)
+    for (int w : e.rot[v])
+      if (w >= 0 && w < e.n && w != v) adj[v].push_back(w);
+  return adj;
+}
+
+std::string canonical(const Embedding& e, bool graph, bool mirror, Canon& c)
+{
+  if (!e.error.empty()) return e.error;
+  if (!graph) return canonical_embedding(e, c, mirror);
+  c = canonical_graph(graph_of(e));
+  return "";
+}
+
+// e with vertex v renamed perm[v], the rotations started elsewhere, and reflected
+Embedding relabel(const Embedding& e, const std::vector<int>& perm, bool reflect, std::mt19937_64& rng)
+{
+  Embedding r;
+  r.name = e.name;
+  r.n = e.n;
+  r.rot.assign(e.n, {});
+  for (int v = 0; v < e.n; ++v) {
+    std::vector<int>& l = r.rot[perm[v]];
+    for (int w : e.rot[v]) l.push_back(perm[w]);
+    if (reflect) std::reverse(l.begin(), l.end());
+    if (!l.empty()) std::rotate(l.begin(), l.begin() + rng() % l.size(), l.end());
+  }
+  for (const auto& x : e.cross) {
+    std::array<int, 4> c = { perm[x[0]], perm[x[1]], perm[x[2]], perm[x[3]] };
+    if (reflect) std::reverse(c.begin(), c.end());
+    std::rotate(c.begin(), c.begin() + rng() % 4, c.end());
+    r.cross.push_back(c);
+  }
+  return r;
+}
+
+std::vector<std::vector<int>> relabel(const std::vector<std::vector<int>>& adj, const std::vector<int>& perm)
+{
+  std::vector<std::vector<int>> r(adj.size());
+  for (std::size_t v = 0; v < adj.size(); ++v)
+    for (int w : adj[v]) r[perm[v]].push_back(perm[w]);
+  return r;
+}
+
+std::vector<int> random_perm(int n, std::mt19937_64& rng)
+{
+  std::vector<int> p(n);
+  for (int i = 0; i < n; ++i) p[i] = i;
+  std::shuffle(p.begin(), p.end(), rng);
+  return p;
+}
+
+int check(const std::vector<Embedding>& all, bool mirror, int k)
+{
+  std::mt19937_64 rng(1);
+  int failures = 0;
+  for (const Embedding& e : all) {
+    Canon c;
+    const std::string err = canonical_embedding(e, c, mirror);
+    if (!err.empty()) { std::cout << e.name << ": " << err << "\n"; ++failures; continue; }
+    const Canon g = canonical_graph(graph_of(e));
+    for (int t = 0; t < k; ++t) {
+      const Embedding r = relabel(e, random_perm(e.n, rng), mirror && t % 2 == 1, rng);
+      Canon d;
+      canonical_embedding(r, d, mirror);
+      if (d.form != c.form) { std::cout << "FAIL: " << e.name << ": relabeled embedding has another form\n"; ++failures; break; }
+      if (canonical_graph(graph_of(r)).form != g.form) { std::cout << "FAIL: " << e.name << ": relabeled graph has another form\n"; ++failures; break; }
+    }
+  }
+
+  // random graphs, from sparse to dense
+  for (int t = 0; t < 200; ++t) {
+    const int n = 5 + (int)(rng() % 40);
+    const double p = 0.05 + 0.9 * (rng() % 1000) / 1000.0;
+    std::vector<std::vector<int>> adj(n);
+    for (int u = 0; u < n; ++u)
+      for (int v = u + 1; v < n; ++v)
+        if ((rng() % 1000) < p * 1000) { adj[u].push_back(v); adj[v].push_back(u); }
+    const Canon c = canonical_graph(adj);
+    for (int r = 0; r < k; ++r)
+      if (canonical_graph(relabel(adj, random_perm(n, rng))).form != c.form) {
+        std::cout << "FAIL: random graph " << t << " (n " << n << ") relabeled has another form\n";
+        ++failures;
+        break;
+      }
+  }
+
+  // all 2^15 graphs on 6 vertices fall into 156 classes
+  Canon_set set;
+  for (int mask = 0; mask < 1 << 15; ++mask) {
+    std::vector<std::vector<int>> adj(6);
+    for (int u = 0, b = 0; u < 6; ++u)
+      for (int v = u + 1; v < 6; ++v, ++b)
+        if (mask >> b & 1) { adj[u].push_back(v); adj[v].push_back(u); }
+    set.insert(canonical_graph(adj));
+  }
+  if (set.size() != 156) {
+    std::cout << "FAIL: " << set.size() << " classes of graphs on 6 vertices, expected 156\n";
+    ++failures;
+  }
+  std::cout << (failures == 0 ? "ok" : "FAILED") << ": " << all.size() << " embeddings relabeled " << k
+            << " times, 200 random graphs, " << set.size() << " graphs on 6 vertices\n";
+  return failures;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bool graph = false, mirror = true, verbose = false;
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  int check_k = 0;
+  std::string write;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--graph") graph = true;
+    else if (a == "--no-mirror") mirror = false;
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--write" && i + 1 < argc) write = argv[++i];
+    else if (a == "--check" && i + 1 < argc) check_k = std::max(1, std::atoi(argv[++i]));
+    else if (a == "-v") verbose = true;
+    else if (!a.empty() && a[0] == '-') {
+      std::cerr << "usage: canon [--graph] [--no-mirror] [-j threads] [--write file] [-v] [embeddings...]\n"
+                   "       canon --check k [embeddings...]\n";
+      return 1;
+    }
+    else files.push_back(a);
+  }
+
+  std::vector<Embedding> all;
+  if (files.empty() && check_k == 0) all = read_embeddings(std::cin, "<stdin>");
+  for (const std::string& f : files) {
+    std::ifstream in(f);
+    if (!in) { std::cerr << "cannot open " << f << "\n"; return 1; }
+    std::vector<Embedding> part = read_embeddings(in, f);
+    for (Embedding& g : part) all.push_back(std::move(g));
+  }
+  if (check_k > 0) return check(all, mirror, check_k) == 0 ? 0 : 1;
+
+  Canon_set set;
+  std::vector<long long> cls(all.size(), -1);
+  std::vector<std::string> error(all.size());
+  std::atomic<std::size_t> next(0);
+  const auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t)
+    pool.emplace_back([&] {
+      for (std::size_t k; (k = next++) < all.size(); ) {
+        Canon c;
+        error[k] = canonical(all[k], graph, mirror, c);
+        if (error[k].empty()) set.insert(c, &cls[k]);
+      }
+    });
+  for (auto& th : pool) th.join();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  // the first input of each class, in input order
+  std::vector<std::size_t> first(set.size(), all.size());
+  for (std::size_t k = 0; k < all.size(); ++k)
+    if (cls[k] >= 0) first[cls[k]] = std::min(first[cls[k]], k);
+  int errors = 0;
+  std::ofstream out;
+  if (!write.empty()) out.open(write);
+  for (std::size_t k = 0; k < all.size(); ++k) {
+    if (!error[k].empty()) { std::cout << all[k].name << ": " << error[k] << "\n"; ++errors; continue; }
+    if (first[cls[k]] != k) {
+      if (verbose) std::cout << all[k].name << ": same as " << all[first[cls[k]]].name << "\n";
+    }
+    else if (out.is_open()) write_embedding(out, all[k]);
+  }
+  std::cout << all.size() << " inputs, " << set.size() << " classes" << (graph ? " of graphs" : "")
+            << ", " << (all.empty() ? 0 : seconds / all.size() * 1e6) << " us each\n";
+  return errors == 0 ? 0 : 1;
+}
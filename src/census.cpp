@@ -0,0 +1,431 @@
+// Cell-type census of concrete 1-plane embeddings and soundness check of a formulation:
+// computes the LP variables of each embedding directly from its planarization and
+// reports every row of the chosen formulation that the counts violate.
+//
+//   census [--model basic|extended|no8|full] [-j threads] [-v] [files...]
+//
+// Without files the embeddings are read from stdin, see embedding.h for the format.
+// The normalization row n-2=factor is not checked; rows mentioning a variable the
+// census does not know are reported as unchecked.
+#include "lp_model.h"
+#include "embedding.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+//// Cells
+// The size of a cell is 2 per planar edge and 3 per crossing on its boundary,
+// so c5 = crossing + edge, c6 = two crossings, t6 = triangle, c7 = crossing + two edges.
+struct Cell {
+  int planar = 0;    // boundary edges between two real vertices
+  int crossings = 0; // crossings on the boundary
+  int size() const { return 2 * planar + 3 * crossings; }
+};
+
+// size as a single character, 'u' for sizes above 9
+char size_char(const Cell& c)
+{
+  const int s = c.size();
+  if (s == 6 && c.crossings == 0) return 't';
+  return s <= 9 ? char('0' + s) : 'u';
+}
+
+// canonical representative of a cyclic sequence up to rotation and reflection
+std::string bracelet(const std::string& s)
+{
+  std::string best = s, r = s;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (std::size_t i = 0; i < r.size(); ++i) {
+      std::rotate(r.begin(), r.begin() + 1, r.end());
+      best = std::min(best, r);
+    }
+    std::reverse(r.begin(), r.end());
+  }
+  return best;
+}
+
+// does some rotation or reflection of s match the pattern? ('x' is anything but 5 and 7)
+bool matches(const std::string& pattern, const std::string& s)
+{
+  if (pattern.size() != s.size()) return false;
+  std::string r = s;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (std::size_t i = 0; i < r.size(); ++i) {
+      std::rotate(r.begin(), r.begin() + 1, r.end());
+      bool ok = true;
+      for (std::size_t k = 0; k < r.size() && ok; ++k)
+        ok = (pattern[k] == 'x') ? (r[k] != '5' && r[k] != '7') : (pattern[k] == r[k]);
+      if (ok) return true;
+    }
+    std::reverse(r.begin(), r.end());
+  }
+  return false;
+}
+
+//// Census of one embedding
+struct Census {
+  long long n = 0, E = 0, X = 0, F = 0;
+  std::map<int,long long> degree;           // vertices per degree
+  std::map<char,long long> cells;           // cells per class
+  long long s1 = 0, s2 = 0, s3 = 0, sx = 0; // corners and crossings of u-cells
+  std::map<std::string,long long> edges;    // planar edges by sorted classes of their sides
+  std::map<std::string,long long> wedges;   // crossings by the sizes of their cells
+  std::map<std::string,long long> pairs;    // "<size><wedge><wedge>" per cell with two crossings
+  std::map<std::string,long long> vtypes;   // "<degree>:<bracelet of cell classes>"
+  long long c7_full_tr = 0, c7_partial_tr = 0, c7_arr = 0, c7c5_e = 0;
+};
+
+// cell classes of a formulation: 5, 6, 7, t and, if it has c8, 8 (two crossings
+// and a planar edge); 'u' for the rest
+struct Classes {
+  bool c8 = false;
+  char of(const Cell& c) const {
+    const char s = size_char(c);
+    if (s == '8') return (c8 && c.crossings == 2) ? s : 'u';
+    return (s == '5' || s == '6' || s == '7' || s == 't') ? s : 'u';
+  }
+};
+
+Census take_census(const Embedding& g, const Planarization& p, const Classes& classes)
+{
+  Census cs;
+  cs.n = g.n;
+  cs.X = (long long)g.cross.size();
+  cs.F = p.num_faces();
+  for (int v = 0; v < g.n; ++v) {
+    cs.E += (long long)g.rot[v].size();
+    ++cs.degree[(int)g.rot[v].size()];
+  }
+  cs.E /= 2;
+
+  std::vector<Cell> cell(p.num_faces());
+  std::vector<char> cls(p.num_faces());
+  std::vector<int> cell_crossing(p.num_faces(), -1); // some crossing on the cell
+  for (std::size_t h = 0; h < p.tail.size(); ++h) {
+    Cell& c = cell[p.face[h]];
+    if (p.is_crossing(p.tail[h])) { ++c.crossings; cell_crossing[p.face[h]] = p.tail[h]; }
+    else if (!p.is_crossing(p.head((int)h))) ++c.planar;
+  }
+  for (int f = 0; f < p.num_faces(); ++f) {
+    cls[f] = classes.of(cell[f]);
+    ++cs.cells[cls[f]];
+  }
+
+  // corners of u-cells: s1 between two planar edges, s2 between a planar edge
+  // and a crossing, s3 between two crossings
+  for (int f = 0; f < p.num_faces(); ++f) {
+    if (cls[f] != 'u') continue;
+    cs.sx += cell[f].crossings;
+    int h = p.first[f];
+    do {
+      const int nx = p.fnext(h);
+      if (!p.is_crossing(p.head(h))) {
+        const int k = p.is_crossing(p.tail[h]) + p.is_crossing(p.head(nx));
+        (k == 0 ? cs.s1 : k == 1 ? cs.s2 : cs.s3) += 1;
+      }
+      h = nx;
+    } while (h != p.first[f]);
+  }
+
+  // planar edges by the classes of their two sides
+  for (std::size_t h = 0; h < p.tail.size(); h += 2) {
+    if (p.is_crossing(p.tail[h]) || p.is_crossing(p.tail[h + 1])) continue;
+    std::string k = {cls[p.face[h]], cls[p.face[h + 1]]};
+    std::sort(k.begin(), k.end());
+    ++cs.edges[k];
+  }
+
+  // wedges: the four cells around each crossing
+  std::vector<std::string> wedge(g.cross.size());
+  for (std::size_t i = 0; i < g.cross.size(); ++i) {
+    const int h0 = p.out[p.nv + i];
+    int h = h0;
+    do { wedge[i] += size_char(cell[p.face[h]]); h = p.rnext[h]; } while (h != h0);
+    ++cs.wedges[bracelet(wedge[i])];
+  }
+  for (int f = 0; f < p.num_faces(); ++f) {
+    if (cell[f].crossings != 2) continue;
+    std::vector<std::string> w;
+    int h = p.first[f];
+    do {
+      if (p.is_crossing(p.tail[h])) w.push_back(bracelet(wedge[p.tail[h] - p.nv]));
+      h = p.fnext(h);
+    } while (h != p.first[f]);
+    std::sort(w.begin(), w.end());
+    ++cs.pairs[size_char(cell[f]) + w[0] + w[1]];
+  }
+
+  // vertex types: degree and the classes of the cells around the vertex
+  for (int v = 0; v < g.n; ++v) {
+    if (p.out[v] < 0) continue;
+    std::string t;
+    int h = p.out[v];
+    do { t += cls[p.face[h]]; h = p.rnext[h]; } while (h != p.out[v]);
+    ++cs.vtypes[std::to_string(g.rot[v].size()) + ":" + bracelet(t)];
+  }
+
+  // neighbourhoods of c7 cells (crossing + two planar edges)
+  for (int f = 0; f < p.num_faces(); ++f) {
+    if (cls[f] != '7') continue;
+    std::vector<int> side;
+    int h = p.first[f];
+    do {
+      if (!p.is_crossing(p.tail[h]) && !p.is_crossing(p.head(h))) side.push_back(p.face[h ^ 1]);
+      h = p.fnext(h);
+    } while (h != p.first[f]);
+    if (side.size() != 2) continue;
+    const int tr = (cls[side[0]] == 't') + (cls[side[1]] == 't');
+    const int c5 = (cls[side[0]] == '5') + (cls[side[1]] == '5');
+    const bool full_tr = tr == 2 && side[0] == side[1];
+    const bool arr = c5 == 2 && side[0] != side[1] && cell_crossing[side[0]] == cell_crossing[side[1]];
+    cs.c7_full_tr += full_tr;
+    cs.c7_partial_tr += tr - 2 * full_tr;
+    cs.c7_arr += arr;
+    cs.c7c5_e += c5 - 2 * arr;
+  }
+  return cs;
+}
+
+//// Variables by name
+// evaluates the variable with the given name on a census; false if unknown
+bool value(const std::string& name, const Census& cs, long long& v)
+{
+  auto starts = [&](const std::string& p) { return name.compare(0, p.size(), p) == 0; };
+  auto cls_char = [](const std::string& c) {
+    return c == "t" ? 't' : c == "u" ? 'u' : (c.size() == 2 && c[0] == 'c') ? c[1] : '?';
+  };
+  auto get = [](const std::map<char,long long>& m, char k) {
+    auto it = m.find(k);
+    return it == m.end() ? 0LL : it->second;
+  };
+
+  v = 0;
+  if (name == "#num_vertices") v = cs.n;
+  else if (name == "#edges") v = cs.E;
+  else if (name == "#crossings") v = cs.X;
+  else if (name == "#cells") v = cs.F;
+  else if (name == "#noncrossing_edges") v = cs.E - 2 * cs.X;
+  else if (name == "#crossing_edges") v = 2 * cs.X;
+  else if (starts("#num_vertices_deg_geq_")) {
+    const int d = std::stoi(name.substr(22));
+    for (const auto& e : cs.degree) if (e.first >= d) v += e.second;
+  }
+  else if (starts("#num_vertices_deg_")) {
+    auto it = cs.degree.find(std::stoi(name.substr(18)));
+    if (it != cs.degree.end()) v = it->second;
+  }
+  else if (name == "t6") v = get(cs.cells, 't');
+  else if (name == "u") v = get(cs.cells, 'u');
+  else if (name.size() == 2 && name[0] == 'c' && name[1] >= '5' && name[1] <= '8') v = get(cs.cells, name[1]);
+  else if (name == "sx") v = cs.sx;
+  else if (name == "s1") v = cs.s1;
+  else if (name == "s2") v = cs.s2;
+  else if (name == "s3") v = cs.s3;
+  else if (starts("noncrossing_edges_")) {
+    const std::string rest = name.substr(18);
+    const std::size_t us = rest.find('_');
+    if (us == std::string::npos) return false;
+    std::string k = {cls_char(rest.substr(0, us)), cls_char(rest.substr(us + 1))};
+    if (k.find('?') != std::string::npos) return false;
+    std::sort(k.begin(), k.end());
+    auto it = cs.edges.find(k);
+    if (it != cs.edges.end()) v = it->second;
+  }
+  else if (starts("wedge ")) {
+    std::istringstream ss(name.substr(6));
+    std::string a, to, b, via, c;
+    ss >> a >> to >> b >> via >> c;
+    if (to.empty()) {
+      for (const auto& e : cs.wedges) if (matches(a, e.first)) v += e.second;
+    }
+    else {
+      if (to != "to" || b.empty()) return false;
+      char shared = '6';
+      if (!via.empty()) {
+        if (via != "via" || c.size() != 2 || c[0] != 'c') return false;
+        shared = c[1];
+      }
+      for (const auto& e : cs.pairs) {
+        if (e.first[0] != shared) continue;
+        const std::string w1 = e.first.substr(1, 4), w2 = e.first.substr(5, 4);
+        if ((matches(a, w1) && matches(b, w2)) || (matches(a, w2) && matches(b, w1))) v += e.second;
+      }
+    }
+  }
+  else if (starts("degree ")) {
+    std::istringstream ss(name.substr(7));
+    int d;
+    std::string vertex, with, cells, t;
+    if (!(ss >> d >> vertex >> with >> cells >> t) || cells != "cells") return false;
+    auto it = cs.vtypes.find(std::to_string(d) + ":" + bracelet(t));
+    if (it != cs.vtypes.end()) v = it->second;
+  }
+  else if (name == "c7 adj to edges from same triangle") v = cs.c7_full_tr;
+  else if (name == "c7 adj to edges from single triangle") v = cs.c7_partial_tr;
+  else if (name == "c7 adj to edges from same arrow") v = cs.c7_arr;
+  else if (name == "c7 adj to edges from c5 but not same arrow") v = cs.c7c5_e;
+  else return false;
+  return true;
+}
+
+//// Rows of the formulation
+struct Row {
+  std::vector<std::pair<int,long long>> a;
+  CGAL::Comparison_result r;
+  long long b;
+};
+
+struct Check {
+  const Model* m;
+  Classes classes;
+  std::vector<Row> rows;
+};
+
+std::string row_name(const Model& m, std::size_t i)
+{
+  return "#" + std::to_string(i) + " \"" + (i < m.cname.size() ? m.cname[i] : std::string("?")) + "\"";
+}
+
+std::string check_embedding(const Embedding& g, Check& chk, bool verbose, std::vector<int>& violated)
+{
+  std::ostringstream out;
+  out << g.name << ": ";
+  if (!g.error.empty()) { out << "error: " << g.error << "\n"; return out.str(); }
+  Planarization p;
+  const std::string err = planarize(g, p);
+  if (!err.empty()) { out << "error: " << err << "\n"; return out.str(); }
+
+  const Census cs = take_census(g, p, chk.classes);
+  const Model& m = *chk.m;
+  std::vector<long long> val(m.vname.size());
+  std::vector<bool> known(m.vname.size());
+  for (std::size_t j = 0; j < m.vname.size(); ++j) {
+    long long v;
+    known[j] = value(m.vname[j], cs, v);
+    val[j] = v;
+  }
+
+  std::ostringstream rows;
+  int bad = 0, unchecked = 0;
+  for (std::size_t i = 0; i < chk.rows.size(); ++i) {
+    if ((int)i == m.norm_row) continue;
+    const Row& row = chk.rows[i];
+    long long lhs = 0;
+    bool ok = true;
+    for (const auto& e : row.a) {
+      if (!known[e.first]) { ok = false; break; }
+      lhs += e.second * val[e.first];
+    }
+    if (!ok) { ++unchecked; continue; }
+    const bool holds = (row.r == CGAL::SMALLER) ? lhs <= row.b
+                     : (row.r == CGAL::LARGER) ? lhs >= row.b : lhs == row.b;
+    if (holds) continue;
+    ++bad;
+    ++violated[i];
+    const char* rel = (row.r == CGAL::SMALLER) ? "<= " : (row.r == CGAL::LARGER) ? ">= " : "= ";
+    rows << "  violated " << row_name(m, i) << ": a.x = " << lhs << ", expected " << rel << row.b << "\n";
+  }
+
+  out << "n=" << cs.n << " E=" << cs.E << " X=" << cs.X << ", "
+      << bad << " violated, " << unchecked << " unchecked\n" << rows.str();
+  if (verbose) {
+    for (std::size_t j = 0; j < m.vname.size(); ++j) {
+      if (known[j]) out << "  " << m.vname[j] << " = " << val[j] << "\n";
+      else out << "  " << m.vname[j] << " = ?\n";
+    }
+  }
+  return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset = "basic";
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  bool verbose = false;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else if (a == "-v") verbose = true;
+    else files.push_back(a);
+  }
+
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+
+  // rows of the program as sparse integer rows
+  const int rows = m.lp.get_m(), cols = m.lp.get_n();
+  Check chk;
+  chk.m = &m;
+  chk.rows.resize(rows);
+  for (int j = 0; j < cols; ++j) {
+    auto col = m.lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (col[i] != 0) chk.rows[i].a.push_back({j, (long long)col[i]});
+  }
+  for (int i = 0; i < rows; ++i) {
+    chk.rows[i].r = m.lp.get_r()[i];
+    chk.rows[i].b = m.lp.get_b()[i];
+  }
+  for (const std::string& v : m.vname) chk.classes.c8 |= (v == "c8");
+
+  if ((int)m.cname.size() != rows)
+    std::cout << "warning: " << m.cname.size() << " row names for " << rows
+              << " rows, names after a missing ++ccc are shifted\n";
+  {
+    Census none;
+    long long v;
+    for (const std::string& name : m.vname)
+      if (!value(name, none, v)) std::cout << "warning: no census for variable \"" << name << "\"\n";
+  }
+
+  // read everything, then check in parallel
+  std::vector<Embedding> all;
+  if (files.empty()) all = read_embeddings(std::cin, "<stdin>");
+  for (const std::string& f : files) {
+    std::ifstream in(f);
+    if (!in) { std::cerr << "cannot open " << f << "\n"; return 1; }
+    std::vector<Embedding> part = read_embeddings(in, f);
+    for (Embedding& g : part) all.push_back(std::move(g));
+  }
+
+  std::vector<std::string> report(all.size());
+  std::vector<std::vector<int>> violated(threads, std::vector<int>(rows, 0));
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      for (std::size_t k; (k = next++) < all.size(); )
+        report[k] = check_embedding(all[k], chk, verbose, violated[t]);
+    });
+  }
+  for (auto& th : pool) th.join();
+
+  for (const std::string& r : report) std::cout << r;
+
+  // summary over the corpus
+  std::cout << "\n" << all.size() << " embeddings checked against " << preset << "\n";
+  int bad_rows = 0;
+  for (int i = 0; i < rows; ++i) {
+    int total = 0;
+    for (unsigned t = 0; t < threads; ++t) total += violated[t][i];
+    if (total == 0) continue;
+    ++bad_rows;
+    std::cout << "  " << row_name(m, i) << " violated by " << total << "\n";
+  }
+  if (bad_rows == 0) std::cout << "  no violated rows\n";
+  return bad_rows == 0 ? 0 : 2;
+}
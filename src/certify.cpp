@@ -0,0 +1,85 @@
+// Re-verifies the bounds of the formulations from stored optimal bases (see
+// basis.h): no simplex iterations when the basis still certifies the model,
+// a full solve (and a new basis file) when it does not.
+//
+//   certify [--model basic|extended|no8|full]... [--dir bases] [--force] [-j threads]
+//
+// Without --model all formulations are checked. The basis of a formulation is
+// <dir>/<model>.basis; --force solves from scratch and rewrites it. Exit code 1
+// if a formulation could not be certified at all. -j solves the basis systems
+// multi-modularly on that many threads (modular.h) instead of over the rationals.
+// With LP_GMP_ARENA set the full solves run in a GMP arena (gmp_arena.h).
+#include "basis.h"
+#include "telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> presets;
+  std::string dir = ".";
+  bool force = false;
+  int threads = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) presets.push_back(argv[++i]);
+    else if (a == "--dir" && i + 1 < argc) dir = argv[++i];
+    else if (a == "--force") force = true;
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else {
+      std::cerr << "usage: certify [--model basic|extended|no8|full]... [--dir bases] [--force] [-j threads]\n";
+      return 1;
+    }
+  }
+  if (presets.empty()) presets = density_presets();
+  const bool arena = gmp_arena_requested();
+
+  int failures = 0;
+  for (const std::string& preset : presets) {
+    Telemetry tel("certify", preset);
+    tel.begin("build");
+    Model m;
+    if (!build_model(preset, m)) {
+      std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+      return 1;
+    }
+    tel.model(m);
+    const std::string path = dir + "/" + preset + ".basis";
+    const auto t0 = std::chrono::steady_clock::now();
+    auto ms = [&] { return 1000 * std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); };
+
+    std::string why = "forced";
+    if (!force) {
+      tel.begin("certify");
+      Basis b;
+      Density_result r;
+      why = read_basis(path, m, b);
+      if (why.empty()) why = certify_basis(m, b, r, threads);
+      if (why.empty()) {
+        std::cout << preset << ": |E| leq " << r.bound << "n certified from " << path << " (0 pivots, " << ms() << " ms)\n";
+        continue;
+      }
+    }
+
+    tel.begin("solve");
+    Density_options o;
+    o.arena = arena;
+    const Density_result r = solve_density(m, o);
+    tel.arena(r.arena);
+    const std::string check = r.status == Density_status::optimal ? verify_density(m, r) : "not optimal";
+    if (!check.empty()) {
+      std::cout << preset << ": FAIL, " << check << "\n";
+      ++failures;
+      continue;
+    }
+    const Basis b = basis_of(preset, m, r);
+    tel.begin("output");
+    const bool written = write_basis(path, m, b);
+    std::cout << preset << ": |E| leq " << r.bound << "n solved (" << why << "; " << r.pivots << " pivots, "
+              << ms() << " ms), " << (written ? "wrote " : "could not write ") << path << "\n";
+    if (!written) ++failures;
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include "density_lp.h"
+#include "presolve.h"
+#include "scaling.h"
+#include "symmetry.h"
+
+namespace {
+
+Rational q(const CGAL::Quotient<ET>& x)
+{
+  return Rational(x.numerator(), x.denominator());
+}
+
+std::string row_name(const Model& m, int i)
+{
+  return i < (int)m.cname.size() ? m.cname[i] : "#" + std::to_string(i);
+}
+
+std::string var_name(const Model& m, int j)
+{
+  return j < (int)m.vname.size() ? m.vname[j] : "#" + std::to_string(j);
+}
+
+// the result with limbs of its own, once the arena has stopped
+void detach_result(Density_result& r)
+{
+  r.objective = detach(r.objective);
+  r.bound = detach(r.bound);
+  for (auto* v : { &r.values, &r.multipliers, &r.direction })
+    for (Named_value& x : *v) x.value = detach(x.value);
+}
+
+} // namespace
+
+std::vector<std::string> density_presets()
+{
+  return { "basic", "extended", "no8", "full" };
+}
+
+namespace {
+
+Density_result solve(const Model& given, const Density_options& options)
+{
+  Density_result r;
+  Model m = given;
+  Program& lp = m.lp;
+  if (options.drop_density_row) {
+    if (m.density_row < 0) {
+      r.error = "the model has no density row to drop";
+      return r;
+    }
+    for (int j = 0; j < lp.get_n(); ++j) lp.set_a(j, m.density_row, 0);
+    lp.set_b(m.density_row, 0);
+  }
+  if (options.presolve) {
+    const Implied_bounds ib = implied_bounds(m);
+    if (!ib.infeasible.empty()) {
+      r.status = Density_status::infeasible;
+      r.error = "presolve: row \"" + ib.infeasible + "\" cannot be satisfied";
+      return r;
+    }
+    apply_bounds(m, ib);
+  }
+  Scaling sc;
+  if (options.scale) sc = scale_model(m);
+  r.rows = lp.get_m();
+  r.columns = lp.get_n();
+
+  const Solution s = solve_lp(lp, options.solver);
+  r.pivots = s.number_of_iterations();
+  if (s.is_infeasible()) {
+    r.status = Density_status::infeasible;
+    return r;
+  }
+  if (options.values) {
+    std::vector<Rational> x;
+    for (auto it = s.variable_values_begin(); it != s.variable_values_end(); ++it) x.push_back(q(*it));
+    unscale_values(sc, x);
+    for (std::size_t j = 0; j < x.size(); ++j) r.values.push_back({ (int)j, var_name(m, (int)j), x[j] });
+  }
+  if (s.is_unbounded()) {
+    r.status = Density_status::unbounded;
+    if (options.certificate) {
+      std::vector<Rational> d;
+      for (auto it = s.unboundedness_certificate_begin(); it != s.unboundedness_certificate_end(); ++it) d.push_back(Rational(*it));
+      unscale_values(sc, d);
+      for (std::size_t j = 0; j < d.size(); ++j) r.direction.push_back({ (int)j, var_name(m, (int)j), d[j] });
+    }
+    return r;
+  }
+  r.status = Density_status::optimal;
+  r.objective = q(s.objective_value());
+  r.bound = -r.objective / Rational(m.factor);
+  if (options.certificate) {
+    std::vector<Rational> l;
+    for (auto it = s.optimality_certificate_begin(); it != s.optimality_certificate_end(); ++it) l.push_back(q(*it));
+    unscale_multipliers(sc, l);
+    for (std::size_t i = 0; i < l.size(); ++i)
+      if (l[i] != 0) r.multipliers.push_back({ (int)i, row_name(m, (int)i), l[i] });
+  }
+  return r;
+}
+
+} // namespace
+
+Density_result solve_density(const Model& m, const Density_options& options)
+{
+  if (!options.arena) return solve(m, options);
+  Density_result r;
+  Gmp_arena_stats st;
+  {
+    Gmp_arena arena(true, &st);
+    r = solve(m, options);
+    arena.stop();
+    detach_result(r);
+  }
+  r.arena = st;
+  return r;
+}
+
+Density_result solve_density(const std::string& preset, const Density_options& options)
+{
+  Model m;
+  if (!build_model(preset, m)) {
+    Density_result r;
+    r.error = "unknown model " + preset;
+    return r;
+  }
+  return solve_density(m, options);
+}
+
+std::string verify_density(const Model& m, const Density_result& r)
+{
+  const Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  if (r.status != Density_status::optimal) return "not an optimal result";
+  if ((int)r.values.size() != cols) return "no values (solve with values on)";
+
+  std::vector<Rational> x;
+  for (const Named_value& v : r.values) x.push_back(v.value);
+  const std::string infeasible = check_feasible(m, x);
+  if (!infeasible.empty()) return infeasible;
+  Rational cx(lp.get_c0());
+  for (int j = 0; j < cols; ++j) cx += Rational(lp.get_c()[j]) * x[j];
+  if (cx != r.objective) return "the values do not attain the objective";
+
+  // multipliers by row; with them  c + A^T l  bounded below over the variable
+  // bounds gives the dual bound, which has to reach the objective
+  std::vector<Rational> l(rows, Rational(0));
+  for (const Named_value& v : r.multipliers) {
+    const int i = v.index;
+    if (i < 0 || i >= rows) return "multiplier for row #" + std::to_string(i) + ", which m does not have";
+    l[i] = v.value;
+    const CGAL::Comparison_result rel = lp.get_r()[i];
+    if ((rel == CGAL::SMALLER && v.value < 0) || (rel == CGAL::LARGER && v.value > 0))
+      return "multiplier of row \"" + row_name(m, i) + "\" has the wrong sign";
+  }
+  Rational dual(lp.get_c0());
+  for (int i = 0; i < rows; ++i) dual -= l[i] * Rational(lp.get_b()[i]);
+  for (int j = 0; j < cols; ++j) {
+    Rational d(lp.get_c()[j]);
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (l[i] != 0 && col[i] != 0) d += l[i] * Rational(col[i]);
+    if (d > 0) {
+      if (!lp.get_fl()[j]) return "no dual bound: " + var_name(m, j) + " has no lower bound";
+      dual += d * Rational(lp.get_l()[j]);
+    }
+    else if (d < 0) {
+      if (!lp.get_fu()[j]) return "no dual bound: " + var_name(m, j) + " has no upper bound";
+      dual += d * Rational(lp.get_u()[j]);
+    }
+  }
+  if (dual != r.objective) return "the multipliers do not prove the objective";
+  return "";
+}
@@ -0,0 +1,72 @@
+// Embeddable interface to the edge density LPs: build a formulation, solve it
+// and get the result as data instead of the text the lp_solver programs print.
+//
+//   Density_options o;
+//   o.presolve = true;
+//   const Density_result r = solve_density("extended", o);
+//   if (r.status == Density_status::optimal) use(r.bound); // |E| leq bound n
+//
+// There is no global state: everything goes in through the arguments and comes
+// back in the result, so independent calls may run on different threads. (The
+// run telemetry of telemetry.h is not used here; callers time what they need.)
+// Results are exact; verify_density() rechecks one against its model.
+#ifndef DENSITY_LP_H
+#define DENSITY_LP_H
+
+#include "gmp_arena.h"
+#include "lp_solve.h"
+
+#include <string>
+#include <vector>
+
+// the names solve_density() and build_model() accept
+std::vector<std::string> density_presets();
+
+struct Density_options {
+  bool presolve = false;         // set the implied bounds of presolve.h before solving
+  bool scale = false;            // solve with the rows and columns scaled (scaling.h); results are unscaled
+  bool drop_density_row = false; // solve without the hand-chosen row E leq 2.4(n-2) + ...
+  bool values = true;            // fill Density_result::values
+  bool certificate = true;       // fill Density_result::multipliers or ::direction
+  bool arena = false;            // GMP memory from an arena (gmp_arena.h), released after the solve
+  CGAL::Quadratic_program_options solver; // pricing strategy, verbosity
+};
+
+enum class Density_status { optimal, infeasible, unbounded, error };
+
+struct Named_value {
+  int index;        // of the variable or row
+  std::string name; // its name in the model
+  Rational value;
+};
+
+struct Density_result {
+  Density_status status = Density_status::error;
+  std::string error;      // what went wrong, for Density_status::error
+  Rational objective;     // optimal value of the program (-factor times the bound)
+  Rational bound;         // |E| leq bound n, when optimal
+  int pivots = 0;
+  int rows = 0, columns = 0;
+  // optimal point, or the feasible base point when unbounded; one per variable
+  std::vector<Named_value> values;
+  // optimality certificate: the rows with a nonzero multiplier (>= 0 on rows <=,
+  // <= 0 on rows >=), with c + A^T multipliers >= 0 on variables at their lower bound
+  std::vector<Named_value> multipliers;
+  // unboundedness certificate: a direction of the values that decreases the objective
+  std::vector<Named_value> direction;
+  Gmp_arena_stats arena;  // with Density_options::arena
+};
+
+// solves a formulation built by the caller (see lp_model.h), which may have been changed
+Density_result solve_density(const Model& m, const Density_options& options = Density_options());
+
+// builds the preset and solves it; an unknown name gives Density_status::error
+Density_result solve_density(const std::string& preset, const Density_options& options = Density_options());
+
+// rechecks an optimal result against m exactly: the values satisfy every row
+// and bound, and the multipliers prove that nothing does better; returns "" or
+// what fails. The result has to be computed with values and certificate on,
+// for the same m (with presolve, build the bounds into m first).
+std::string verify_density(const Model& m, const Density_result& r);
+
+#endif
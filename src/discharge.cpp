@@ -0,0 +1,152 @@
+// Discharging rules from the LP dual: drops the hand-chosen edge density row
+// "E leq 2.4(n-2) + ..." of a formulation, solves what is left and reads the best
+// density formula off the optimality certificate.
+//
+//   discharge [--model basic|extended|no8|full] [--keep]
+//
+// With multipliers l_i (l_i >= 0 on inequalities) the combination of all rows but
+// the normalization n-2=factor is a valid inequality  sum_i l_i A_i x <= sum_i l_i b_i,
+// and the optimal l makes it the strongest one of the form
+//   E leq a n + b + sum_j w_j x_j
+// where the weights w_j of the cell types, crossings, vertex types, ... are the charges
+// (they are <= 0: a count with nonzero weight is thrown away by the proof).
+// Everything is printed as exact rationals. --keep leaves the hand-chosen row in.
+#include "lp_solve.h"
+#include "telemetry.h"
+
+#include <CGAL/Gmpq.h>
+#include <iostream>
+
+namespace {
+
+typedef CGAL::Gmpq Q;
+
+Q lcm(const Q& a, const Q& b)
+{
+  const CGAL::Gmpz x = a.numerator(), y = b.numerator();
+  return Q(CGAL::integral_division(x, CGAL::gcd(x, y)) * y);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset = "basic";
+  bool keep = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--keep") keep = true;
+    else {
+      std::cerr << "usage: discharge [--model basic|extended|no8|full] [--keep]\n";
+      return 1;
+    }
+  }
+
+  Telemetry tel("discharge", preset);
+  tel.begin("build");
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  tel.model(m);
+  Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  if ((int)m.cname.size() != rows)
+    std::cout << "warning: " << m.cname.size() << " row names for " << rows
+              << " rows, names after a missing ++ccc are shifted\n";
+  auto row_name = [&](int i) { return i < (int)m.cname.size() ? m.cname[i] : "#" + std::to_string(i); };
+
+  int E = -1, n = -1;
+  for (int j = 0; j < cols; ++j) {
+    if (m.vname[j] == "#edges") E = j;
+    if (m.vname[j] == "#num_vertices") n = j;
+  }
+  if (E < 0 || n < 0 || m.density_row < 0) {
+    std::cerr << "model " << preset << " has no edge density formula\n";
+    return 1;
+  }
+
+  // the hand-chosen formula, then an empty row in its place (keeps the row numbers)
+  std::cout << "hand-chosen formula:\n  ";
+  for (int j = 0; j < cols; ++j) {
+    const IT a = lp.get_a()[j][m.density_row];
+    if (a != 0) std::cout << (a > 0 ? " +" : " ") << a << " [" << m.vname[j] << "]";
+  }
+  std::cout << " <= " << lp.get_b()[m.density_row] << "\n\n";
+  if (!keep) {
+    for (int j = 0; j < cols; ++j) lp.set_a(j, m.density_row, 0);
+    lp.set_b(m.density_row, 0);
+  }
+
+  tel.begin("solve");
+  Solution s = solve_lp(lp);
+  tel.solved(s);
+  tel.begin("output");
+  if (s.is_unbounded()) {
+    std::cout << "unbounded: the remaining rows do not bound E\n";
+    return 1;
+  }
+  if (!s.is_optimal()) {
+    std::cout << "infeasible\n";
+    return 1;
+  }
+  const Q factor(m.factor);
+  std::cout << "|E| leq " << -Q(s.objective_value().numerator(), s.objective_value().denominator()) / factor
+            << "n (about " << -CGAL::to_double(s.objective_value()) / m.factor << ")"
+            << (keep ? "" : " without the hand-chosen formula") << "\n\n";
+
+  // the rules: rows with a nonzero multiplier
+  std::vector<Q> l;
+  for (auto it = s.optimality_certificate_begin(); it != s.optimality_certificate_end(); ++it)
+    l.push_back(Q(it->numerator(), it->denominator()));
+  std::cout << "Rules (row multipliers):\n";
+  for (int i = 0; i < rows; ++i)
+    if (i != m.norm_row && l[i] != 0) std::cout << "  " << l[i] << "\t" << row_name(i) << "\n";
+
+  // their combination d x <= rhs
+  std::vector<Q> d(cols, Q(0));
+  Q rhs(0);
+  for (int i = 0; i < rows; ++i) {
+    if (i == m.norm_row || l[i] == 0) continue;
+    for (int j = 0; j < cols; ++j) {
+      const IT a = lp.get_a()[j][i];
+      if (a != 0) d[j] += l[i] * Q(a);
+    }
+    rhs += l[i] * Q(lp.get_b()[i]);
+  }
+  if (!(d[E] > Q(0))) {
+    std::cout << "\nthe multipliers do not combine into a bound on E\n";
+    return 1;
+  }
+
+  // E leq a n + b + sum_j w_j x_j
+  const Q a = -d[n] / d[E], b = rhs / d[E];
+  std::cout << "\nDensity formula:\n  E leq " << a << " n";
+  if (b == -a * Q(2)) std::cout << " - " << a * Q(2);
+  else std::cout << " + " << b;
+  std::cout << " + sum of the charges below\n";
+  for (const char* g : { "cells", "crossings", "corners", "vertices", "edges" }) {
+    bool head = false;
+    for (int j = 0; j < cols; ++j) {
+      if (j == E || j == n || d[j] == 0 || family(m.vname[j]) != g) continue;
+      if (!head) std::cout << "  " << g << ":\n";
+      head = true;
+      std::cout << "    " << -d[j] / d[E] << "\t" << m.vname[j] << "\n";
+    }
+  }
+
+  // the same with integer coefficients, in the orientation of the hand-chosen row
+  Q scale(1);
+  for (int j = 0; j < cols; ++j)
+    if (d[j] != 0) scale = lcm(scale, Q((d[j] / d[E]).denominator()));
+  scale = lcm(scale, Q(b.denominator()));
+  std::cout << "\nin integers:\n  ";
+  for (int j = 0; j < cols; ++j)
+    if (d[j] != 0) {
+      const Q c = d[j] / d[E] * scale;
+      std::cout << (c > Q(0) ? " +" : " ") << c << " [" << m.vname[j] << "]";
+    }
+  std::cout << " <= " << b * scale << "\n";
+}
@@ -0,0 +1,165 @@
+#include "embedding.h"
+
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+std::vector<Embedding> read_embeddings(std::istream& in, const std::string& source)
+{
+  std::vector<Embedding> out;
+  std::string line;
+  int lineno = 0;
+  auto fail = [&](const std::string& msg) {
+    if (out.empty()) {
+      out.emplace_back();
+      out.back().name = source + ":" + std::to_string(lineno);
+    }
+    if (out.back().error.empty())
+      out.back().error = "line " + std::to_string(lineno) + ": " + msg;
+  };
+
+  while (std::getline(in, line)) {
+    ++lineno;
+    const std::size_t hash = line.find('#');
+    if (hash != std::string::npos) line.erase(hash);
+    std::istringstream ss(line);
+    std::string tok;
+    if (!(ss >> tok)) continue;
+
+    if (tok == "n") {
+      out.emplace_back();
+      Embedding& g = out.back();
+      g.name = source + ":" + std::to_string(lineno);
+      if (!(ss >> g.n) || g.n < 0) { fail("bad vertex count"); continue; }
+      g.rot.assign(g.n, {});
+    }
+    else if (out.empty()) fail("expected \"n <vertices>\" first");
+    else if (tok == "x") {
+      std::array<int,4> c;
+      if (!(ss >> c[0] >> c[1] >> c[2] >> c[3])) { fail("crossing needs four vertices"); continue; }
+      out.back().cross.push_back(c);
+    }
+    else if (tok.back() == ':') {
+      Embedding& g = out.back();
+      int v = -1;
+      try { v = std::stoi(tok); } catch (...) {}
+      if (v < 0 || v >= g.n) { fail("bad vertex " + tok); continue; }
+      int w;
+      while (ss >> w) g.rot[v].push_back(w);
+    }
+    else fail("cannot parse \"" + tok + "\"");
+  }
+  return out;
+}
+
+void write_embedding(std::ostream& out, const Embedding& g)
+{
+  if (!g.name.empty()) out << "# " << g.name << "\n";
+  out << "n " << g.n << "\n";
+  for (int v = 0; v < g.n; ++v) {
+    out << v << ":";
+    for (int w : g.rot[v]) out << " " << w;
+    out << "\n";
+  }
+  for (const auto& c : g.cross) out << "x " << c[0] << " " << c[1] << " " << c[2] << " " << c[3] << "\n";
+}
+
+std::string planarize(const Embedding& g, Planarization& p)
+{
+  const int n = g.n;
+  const long long N = n + (long long)g.cross.size();
+  auto key = [N](long long a, long long b) { return a * N + b; };
+
+  // symmetric rotation system of a simple graph
+  std::unordered_map<long long, int> edge;  // key(u,w) -> crossing or -1
+  for (int u = 0; u < n; ++u) {
+    for (int w : g.rot[u]) {
+      if (w < 0 || w >= n || w == u) return "bad neighbour " + std::to_string(w) + " of " + std::to_string(u);
+      if (!edge.emplace(key(u, w), -1).second) return "repeated edge " + std::to_string(u) + "-" + std::to_string(w);
+    }
+  }
+  for (const auto& e : edge) {
+    const int u = (int)(e.first / N), w = (int)(e.first % N);
+    if (!edge.count(key(w, u))) return "edge " + std::to_string(u) + "-" + std::to_string(w) + " missing at " + std::to_string(w);
+  }
+
+  // every edge is crossed at most once, by a non-adjacent edge
+  for (std::size_t i = 0; i < g.cross.size(); ++i) {
+    const auto& c = g.cross[i];
+    for (int k = 0; k < 4; ++k) {
+      if (c[k] < 0 || c[k] >= n) return "bad crossing vertex " + std::to_string(c[k]);
+      for (int l = 0; l < k; ++l)
+        if (c[k] == c[l]) return "crossing edges share vertex " + std::to_string(c[k]);
+    }
+    for (int k = 0; k < 4; ++k) {
+      auto it = edge.find(key(c[k], c[(k + 2) % 4]));
+      if (it == edge.end()) return "crossing edge " + std::to_string(c[k]) + "-" + std::to_string(c[(k + 2) % 4]) + " does not exist";
+      if (it->second >= 0 && it->second != (int)i) return "edge " + std::to_string(c[k]) + "-" + std::to_string(c[(k + 2) % 4]) + " crossed twice";
+      it->second = (int)i;
+    }
+  }
+
+  p = Planarization();
+  p.nv = n;
+  p.nodes = (int)N;
+  std::unordered_map<long long, int> half;  // key(tail, head) -> half-edge
+  auto half_edge = [&](int a, int b) {
+    auto it = half.find(key(a, b));
+    if (it != half.end()) return it->second;
+    const int h = (int)p.tail.size();
+    p.tail.push_back(a);
+    p.tail.push_back(b);
+    half[key(a, b)] = h;
+    half[key(b, a)] = h + 1;
+    return h;
+  };
+
+  // half-edges around each node in ccw order
+  std::vector<std::vector<int>> around(N);
+  for (int u = 0; u < n; ++u) {
+    for (int w : g.rot[u]) {
+      const int c = edge[key(u, w)];
+      around[u].push_back(half_edge(u, c < 0 ? w : n + c));
+    }
+  }
+  for (std::size_t i = 0; i < g.cross.size(); ++i)
+    for (int k = 0; k < 4; ++k) around[n + i].push_back(half_edge(n + (int)i, g.cross[i][k]));
+
+  p.rnext.assign(p.tail.size(), -1);
+  p.out.assign(N, -1);
+  for (long long v = 0; v < N; ++v) {
+    const auto& a = around[v];
+    for (std::size_t k = 0; k < a.size(); ++k) p.rnext[a[k]] = a[(k + 1) % a.size()];
+    if (!a.empty()) p.out[v] = a[0];
+  }
+
+  // cells
+  p.face.assign(p.tail.size(), -1);
+  for (int h = 0; h < (int)p.tail.size(); ++h) {
+    if (p.face[h] >= 0) continue;
+    const int f = p.num_faces();
+    p.first.push_back(h);
+    for (int e = h; p.face[e] < 0; e = p.fnext(e)) p.face[e] = f;
+  }
+
+  // Euler's formula for each component: V - E + F = 2, where the traced
+  // cells of a component include its own outer cell (1 for isolated vertices)
+  std::vector<int> comp(N);
+  std::iota(comp.begin(), comp.end(), 0);
+  auto find = [&](int v) {
+    while (comp[v] != v) v = comp[v] = comp[comp[v]];
+    return v;
+  };
+  for (std::size_t h = 0; h < p.tail.size(); h += 2) {
+    const int a = find(p.tail[h]), b = find(p.tail[h + 1]);
+    if (a != b) comp[a] = b;
+  }
+  long long expected = 0;
+  for (long long v = 0; v < N; ++v)
+    if (find((int)v) == v) expected += (p.out[v] < 0) ? 1 : 2;
+  const long long euler = N - (long long)p.tail.size() / 2 + p.num_faces();
+  if (euler != expected)
+    return "not a plane embedding (V - E + F = " + std::to_string(euler)
+         + ", expected " + std::to_string(expected) + ")";
+  return "";
+}
@@ -0,0 +1,53 @@
+// 1-plane embeddings (rotation system plus crossings) and their planarization
+#ifndef EMBEDDING_H
+#define EMBEDDING_H
+
+#include <array>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Text format, one or more embeddings per file:
+//   # comment
+//   n 6              starts a new embedding on vertices 0..5
+//   0: 1 2 3         neighbours of vertex 0 in ccw order
+//   x 0 1 2 3        a crossing; 0 1 2 3 are in ccw order around it,
+//                    so the edges 0-2 and 1-3 cross there
+struct Embedding {
+  std::string name;                    // source:line of the "n" line
+  std::string error;                   // parse error, empty if fine
+  int n = 0;
+  std::vector<std::vector<int>> rot;   // ccw neighbours of each vertex
+  std::vector<std::array<int,4>> cross;
+};
+
+std::vector<Embedding> read_embeddings(std::istream& in, const std::string& source);
+
+// writes g in the format above, preceded by "# name" if it has one
+void write_embedding(std::ostream& out, const Embedding& g);
+
+// The planarization as a half-edge structure. Real vertices are the nodes
+// 0..nv-1, crossings are the nodes nv..nodes-1 (crossing i is node nv+i).
+// Half-edges h and h^1 are twins; h runs from tail[h] to tail[h^1].
+struct Planarization {
+  int nv = 0;
+  int nodes = 0;
+  std::vector<int> tail;
+  std::vector<int> rnext;  // next half-edge ccw around tail[h]
+  std::vector<int> out;    // some half-edge leaving each node
+  std::vector<int> face;   // cell of each half-edge
+  std::vector<int> first;  // some half-edge of each cell
+
+  int head(int h) const { return tail[h ^ 1]; }
+  int fnext(int h) const { return rnext[h ^ 1]; }  // next half-edge along face[h]
+  bool is_crossing(int v) const { return v >= nv; }
+  int num_faces() const { return (int)first.size(); }
+};
+
+// builds the planarization of g; returns an empty string on success and
+// a description of the problem otherwise (asymmetric rotation, bad
+// crossing, or a rotation system that is not plane by Euler's formula)
+std::string planarize(const Embedding& g, Planarization& p);
+
+#endif
@@ -0,0 +1,188 @@
+// Benchmark of the solver's exact type: CGAL::Gmpz against Small_int
+// (small_int.h), on every formulation or the one given.
+//
+//   et_bench [--model basic|extended|no8|full] [--repeat 3] [-v]
+//
+// For each formulation it solves the program with both types (the best of
+// --repeat runs) and counts the GMP allocations of each solve, then runs a
+// fraction-free (Bareiss) elimination of [A | b] with both types, which is the
+// integer arithmetic of an exact simplex without the pivoting rules. The two
+// types must agree exactly on status, optimum and the elimination's rank and
+// last pivot; exit code 1 otherwise. -v prints the bit length of the largest
+// pivot and how many entries of the elimination needed GMP.
+//
+// The solver is instantiated here for both types, whatever LP_SMALL_INT_ET
+// says. How much of the solve Small_int takes off GMP depends on how much of
+// its arithmetic the CGAL build does in ET; the elimination shows the gain on
+// the arithmetic itself.
+#include "lp_model.h"
+#include "small_int.h"
+
+#include <CGAL/QP_functions.h>
+#include <CGAL/QP_solution.h>
+
+#include <atomic>
+#include <chrono>
+#include <gmp.h>
+#include <iostream>
+
+namespace {
+
+//// GMP allocation counts
+void* (*gmp_alloc)(std::size_t);
+void* (*gmp_realloc)(void*, std::size_t, std::size_t);
+void (*gmp_free)(void*, std::size_t);
+std::atomic<long long> allocations(0);
+
+void* counted_alloc(std::size_t bytes)
+{
+  ++allocations;
+  return gmp_alloc(bytes);
+}
+
+void* counted_realloc(void* p, std::size_t old_bytes, std::size_t bytes)
+{
+  ++allocations;
+  return gmp_realloc(p, old_bytes, bytes);
+}
+
+struct Run {
+  double seconds = 1e100;
+  long long allocations = 0;
+};
+
+template <class F> Run measure(int repeat, F f)
+{
+  Run r;
+  for (int k = 0; k < repeat; ++k) {
+    const long long a0 = allocations;
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    r.seconds = std::min(r.seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    r.allocations = allocations - a0;
+  }
+  return r;
+}
+
+//// the exact solve
+struct Optimum {
+  std::string status;
+  CGAL::Gmpq value;
+};
+
+template <class NT> Optimum solve(const Program& lp)
+{
+  const CGAL::Quadratic_program_solution<NT> s = CGAL::solve_linear_program(lp, NT());
+  Optimum o;
+  o.status = s.is_optimal() ? "optimal" : s.is_infeasible() ? "infeasible" : "unbounded";
+  if (s.is_optimal()) o.value = CGAL::Gmpq(CGAL::Gmpz(s.objective_value().numerator()),
+                                           CGAL::Gmpz(s.objective_value().denominator()));
+  return o;
+}
+
+//// fraction-free elimination
+struct Elimination {
+  int rank = 0;
+  CGAL::Gmpz pivot;        // the last pivot, a minor of [A | b]
+  std::size_t bits = 0;    // of the largest pivot
+  long long entries = 0, big = 0; // entries computed, and of those, not fitting 64 bits
+};
+
+std::size_t bit_length(const CGAL::Gmpz& x)
+{
+  return x == 0 ? 0 : mpz_sizeinbase(x.mpz(), 2);
+}
+
+bool fits(const CGAL::Gmpz& x) { return mpz_fits_slong_p(x.mpz()); }
+bool fits(const Small_int& x) { return x.is_small(); }
+
+// Bareiss: after step k every entry below row k is a (k+1)x(k+1) minor, and
+// the division by the previous pivot is exact
+template <class NT> Elimination bareiss(const Program& lp)
+{
+  const int rows = lp.get_m(), cols = lp.get_n() + 1;
+  std::vector<std::vector<NT>> a(rows, std::vector<NT>(cols));
+  for (int j = 0; j < cols - 1; ++j) {
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i) a[i][j] = NT(col[i]);
+  }
+  for (int i = 0; i < rows; ++i) a[i][cols - 1] = NT(lp.get_b()[i]);
+
+  Elimination e;
+  NT prev(1);
+  for (int k = 0, c = 0; k < rows && c < cols; ++c) {
+    int p = k;
+    while (p < rows && a[p][c] == NT(0)) ++p;
+    if (p == rows) continue;
+    std::swap(a[k], a[p]);
+    for (int i = k + 1; i < rows; ++i) {
+      for (int j = c + 1; j < cols; ++j) {
+        a[i][j] = (a[k][c] * a[i][j] - a[i][c] * a[k][j]) / prev;
+        ++e.entries;
+        if (!fits(a[i][j])) ++e.big;
+      }
+      a[i][c] = NT(0);
+    }
+    prev = a[k][c];
+    e.bits = std::max(e.bits, bit_length(CGAL::Gmpz(prev)));
+    ++k;
+    e.rank = k;
+  }
+  e.pivot = CGAL::Gmpz(prev);
+  return e;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<std::string> models = { "basic", "extended", "no8", "full" };
+  int repeat = 3;
+  bool verbose = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) models = { argv[++i] };
+    else if (a == "--repeat" && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+    else if (a == "-v") verbose = true;
+    else {
+      std::cerr << "usage: et_bench [--model basic|extended|no8|full] [--repeat 3] [-v]\n";
+      return 1;
+    }
+  }
+
+  mp_get_memory_functions(&gmp_alloc, &gmp_realloc, &gmp_free);
+  mp_set_memory_functions(counted_alloc, counted_realloc, gmp_free);
+
+  int failures = 0;
+  for (const std::string& name : models) {
+    Model m;
+    if (!build_model(name, m)) {
+      std::cerr << "unknown model " << name << " (basic, extended, no8, full)\n";
+      return 1;
+    }
+    Optimum og, os;
+    const Run sg = measure(repeat, [&] { og = solve<CGAL::Gmpz>(m.lp); });
+    const Run ss = measure(repeat, [&] { os = solve<Small_int>(m.lp); });
+    Elimination eg, es;
+    const Run bg = measure(repeat, [&] { eg = bareiss<CGAL::Gmpz>(m.lp); });
+    const Run bs = measure(repeat, [&] { es = bareiss<Small_int>(m.lp); });
+
+    std::cout << name << " (" << m.lp.get_m() << " rows, " << m.lp.get_n() << " columns)\n"
+              << "  solve        Gmpz " << sg.seconds << " s, " << sg.allocations << " allocations; Small_int "
+              << ss.seconds << " s, " << ss.allocations << " allocations\n"
+              << "  elimination  Gmpz " << bg.seconds << " s, " << bg.allocations << " allocations; Small_int "
+              << bs.seconds << " s, " << bs.allocations << " allocations\n";
+    if (verbose)
+      std::cout << "  rank " << eg.rank << ", largest pivot " << eg.bits << " bits, " << es.big << " of "
+                << es.entries << " entries beyond 64 bits\n";
+    if (og.status != os.status || og.value != os.value) {
+      std::cout << "  FAIL: Gmpz " << og.status << " " << og.value << ", Small_int " << os.status << " " << os.value << "\n";
+      ++failures;
+    }
+    if (eg.rank != es.rank || eg.pivot != es.pivot) {
+      std::cout << "  FAIL: elimination differs (rank " << eg.rank << " and " << es.rank << ")\n";
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,553 @@
+// Orderly generation of C4-free 1-planar graphs up to isomorphism (small n)
+//
+//   gen_c4free [-j threads] [--split level] [--embed] [--c4-only] maxn
+//
+// Graphs are built by adding one vertex at a time (canonical augmentation):
+// a graph on n vertices is accepted only if its new vertex is, up to an
+// automorphism, the canonical vertex to delete, i.e. the one of minimum
+// degree with the largest canonical label. Children of one parent are
+// deduplicated by their canonical form. Both C4-freeness and 1-planarity
+// are hereditary, so every graph of the class is reached exactly once.
+//
+// For each n the number of graphs and the maximum number of edges is printed;
+// with --embed also a 1-plane embedding of an extremal graph in the input
+// format of census (see embedding.h); the table is printed as comments. The search below level --split
+// (default maxn - 2) is shared between the threads.
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/boyer_myrvold_planar_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const int MAXN = 32;
+typedef uint32_t Set;
+
+struct Graph {
+  int n = 0;
+  Set adj[MAXN] = {};
+  vector<array<int,4>> cross; // crossings of a 1-plane drawing: edge a-b crosses c-d
+
+  int degree(int v) const { return __builtin_popcount(adj[v]); }
+  int edges() const {
+    int m = 0;
+    for (int v = 0; v < n; ++v) m += degree(v);
+    return m / 2;
+  }
+};
+
+//// Canonical labeling
+// Individualization-refinement: refine the ordered partition until it is
+// equitable, then individualize each vertex of the first non-trivial cell.
+// Leaves are compared by their relabelled adjacency rows; equal leaves give
+// automorphisms, which prune children in the same orbit.
+struct Canon {
+  vector<int> lab;   // lab[i] = vertex with canonical label i
+  vector<Set> key;   // adjacency rows in canonical order
+  vector<int> orbit; // orbit representative of each vertex under Aut(g)
+};
+
+class Canonizer {
+public:
+  explicit Canonizer(const Graph& g) : g(g) {}
+
+  Canon run(const vector<int>& colour) {
+    vector<vector<int>> cells;
+    vector<int> order(g.n);
+    for (int v = 0; v < g.n; ++v) order[v] = v;
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return colour[a] < colour[b]; });
+    for (int i = 0; i < g.n; ++i) {
+      if (i == 0 || colour[order[i]] != colour[order[i - 1]]) cells.push_back({});
+      cells.back().push_back(order[i]);
+    }
+    vector<int> prefix;
+    search(cells, prefix);
+
+    Canon c;
+    c.lab = best_lab;
+    c.key = best_key;
+    vector<int> uf(g.n);
+    for (int v = 0; v < g.n; ++v) uf[v] = v;
+    for (const auto& gamma : gens) unite(uf, gamma);
+    c.orbit.resize(g.n);
+    for (int v = 0; v < g.n; ++v) c.orbit[v] = find(uf, v);
+    return c;
+  }
+
+private:
+  const Graph& g;
+  bool have_leaf = false;
+  vector<int> first_lab, best_lab;
+  vector<Set> first_key, best_key;
+  vector<vector<int>> gens;
+
+  static int find(vector<int>& uf, int v) {
+    while (uf[v] != v) v = uf[v] = uf[uf[v]];
+    return v;
+  }
+  static void unite(vector<int>& uf, const vector<int>& gamma) {
+    for (size_t v = 0; v < gamma.size(); ++v) {
+      int a = find(uf, (int)v), b = find(uf, gamma[v]);
+      if (a != b) uf[max(a, b)] = min(a, b);
+    }
+  }
+
+  // split cells by the number of neighbours in each cell until nothing changes
+  void refine(vector<vector<int>>& cells) const {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (size_t w = 0; w < cells.size() && !changed; ++w) {
+        Set W = 0;
+        for (int v : cells[w]) W |= Set(1) << v;
+        for (size_t c = 0; c < cells.size(); ++c) {
+          if (cells[c].size() == 1) continue;
+          vector<pair<int,int>> cnt;
+          for (int v : cells[c]) cnt.push_back({__builtin_popcount(g.adj[v] & W), v});
+          stable_sort(cnt.begin(), cnt.end(), [](const pair<int,int>& a, const pair<int,int>& b) { return a.first < b.first; });
+          if (cnt.front().first == cnt.back().first) continue;
+          vector<vector<int>> parts;
+          for (size_t i = 0; i < cnt.size(); ++i) {
+            if (i == 0 || cnt[i].first != cnt[i - 1].first) parts.push_back({});
+            parts.back().push_back(cnt[i].second);
+          }
+          cells.erase(cells.begin() + c);
+          cells.insert(cells.begin() + c, parts.begin(), parts.end());
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  vector<Set> leaf_key(const vector<int>& lab) const {
+    vector<int> pos(g.n);
+    for (int i = 0; i < g.n; ++i) pos[lab[i]] = i;
+    vector<Set> key(g.n, 0);
+    for (int i = 0; i < g.n; ++i) {
+      for (Set a = g.adj[lab[i]]; a; a &= a - 1) key[i] |= Set(1) << pos[__builtin_ctz(a)];
+    }
+    return key;
+  }
+
+  void leaf(const vector<vector<int>>& cells) {
+    vector<int> lab;
+    for (const auto& c : cells) lab.push_back(c[0]);
+    vector<Set> key = leaf_key(lab);
+    if (!have_leaf) {
+      have_leaf = true;
+      first_lab = best_lab = lab;
+      first_key = best_key = key;
+      return;
+    }
+    auto automorphism = [&](const vector<int>& other) {
+      vector<int> gamma(g.n);
+      for (int i = 0; i < g.n; ++i) gamma[lab[i]] = other[i];
+      gens.push_back(gamma);
+    };
+    if (key == first_key) automorphism(first_lab);
+    else if (key == best_key) automorphism(best_lab);
+    else if (key > best_key) { best_key = key; best_lab = lab; }
+  }
+
+  void search(vector<vector<int>> cells, vector<int>& prefix) {
+    refine(cells);
+    size_t t = 0;
+    while (t < cells.size() && cells[t].size() == 1) ++t;
+    if (t == cells.size()) { leaf(cells); return; }
+
+    const vector<int> target = cells[t];
+    vector<int> done;
+    for (int w : target) {
+      // skip w if an automorphism fixing the prefix maps a done child to it
+      if (!done.empty()) {
+        vector<int> uf(g.n);
+        for (int v = 0; v < g.n; ++v) uf[v] = v;
+        for (const auto& gamma : gens) {
+          bool fixes = true;
+          for (int p : prefix) fixes = fixes && gamma[p] == p;
+          if (fixes) unite(uf, gamma);
+        }
+        bool equivalent = false;
+        for (int d : done) equivalent = equivalent || find(uf, d) == find(uf, w);
+        if (equivalent) continue;
+      }
+      done.push_back(w);
+      vector<vector<int>> next = cells;
+      next[t].erase(find_in(next[t], w));
+      next.insert(next.begin() + t, vector<int>{w});
+      prefix.push_back(w);
+      search(next, prefix);
+      prefix.pop_back();
+    }
+  }
+
+  static vector<int>::iterator find_in(vector<int>& v, int x) { return std::find(v.begin(), v.end(), x); }
+};
+
+//// 1-planarity
+// G is 1-planar iff some set of crossing pairs of independent edges, each edge
+// in at most one pair, has a planar planarization. If the planarization is not
+// planar, two still uncrossed edges of its Kuratowski subgraph must cross.
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+                              boost::property<boost::vertex_index_t, int>,
+                              boost::property<boost::edge_index_t, int>> BGraph;
+typedef boost::graph_traits<BGraph>::edge_descriptor BEdge;
+
+struct OnePlanarity {
+  const Graph& g;
+  vector<pair<int,int>> edge;      // edges of g
+  vector<pair<int,int>> cross;     // chosen crossing pairs (edge indices)
+  vector<int> crossed;             // crossing of each edge, -1 if none
+  set<vector<pair<int,int>>> seen;
+  vector<int> index;               // edge index of each vertex pair
+
+  explicit OnePlanarity(const Graph& g) : g(g), index(g.n * g.n, -1) {
+    for (int u = 0; u < g.n; ++u)
+      for (int v = u + 1; v < g.n; ++v)
+        if (g.adj[u] >> v & 1) {
+          index[u * g.n + v] = index[v * g.n + u] = (int)edge.size();
+          edge.push_back({u, v});
+        }
+    crossed.assign(edge.size(), -1);
+  }
+
+  void add_crossing(int e, int f) {
+    cross.push_back({min(e, f), max(e, f)});
+    crossed[e] = crossed[f] = (int)cross.size() - 1;
+  }
+
+  // planarization with the current crossings; seg[i] = edge of g of each segment
+  BGraph planarization(vector<int>& seg) const {
+    BGraph b(g.n + cross.size());
+    seg.clear();
+    for (size_t e = 0; e < edge.size(); ++e) {
+      if (crossed[e] >= 0) continue;
+      boost::add_edge(edge[e].first, edge[e].second, b);
+      seg.push_back((int)e);
+    }
+    for (size_t x = 0; x < cross.size(); ++x) {
+      for (int e : {cross[x].first, cross[x].second}) {
+        boost::add_edge(edge[e].first, g.n + (int)x, b);
+        boost::add_edge(g.n + (int)x, edge[e].second, b);
+        seg.push_back(e);
+        seg.push_back(e);
+      }
+    }
+    int k = 0;
+    boost::graph_traits<BGraph>::edge_iterator ei, ee;
+    for (boost::tie(ei, ee) = boost::edges(b); ei != ee; ++ei) boost::put(boost::edge_index, b, *ei, k++);
+    return b;
+  }
+
+  bool planar() const {
+    vector<int> seg;
+    BGraph b = planarization(seg);
+    return boost::boyer_myrvold_planarity_test(b);
+  }
+
+  // depth-first search over sets of at most limit crossings
+  bool search(size_t limit) {
+    vector<int> seg;
+    BGraph b = planarization(seg);
+    vector<BEdge> kuratowski;
+    if (boost::boyer_myrvold_planarity_test(boost::boyer_myrvold_params::graph = b,
+          boost::boyer_myrvold_params::kuratowski_subgraph = back_inserter(kuratowski)))
+      return true;
+    if (cross.size() == limit) return false;
+
+    // split the Kuratowski subgraph into its branch paths; by the Hanani-Tutte
+    // theorem some two paths without a common end cross
+    const int N = (int)boost::num_vertices(b);
+    vector<vector<pair<int,int>>> kadj(N); // (neighbour, segment)
+    for (const BEdge& be : kuratowski) {
+      const int s = (int)boost::source(be, b), t = (int)boost::target(be, b);
+      const int id = boost::get(boost::edge_index, b, be);
+      kadj[s].push_back({t, id});
+      kadj[t].push_back({s, id});
+    }
+    vector<int> path(seg.size(), -1);
+    vector<pair<int,int>> ends;
+    for (int v = 0; v < N; ++v) {
+      if (kadj[v].size() < 3) continue;
+      for (const auto& start : kadj[v]) {
+        if (path[start.second] >= 0) continue;
+        int cur = start.first, id = start.second;
+        path[id] = (int)ends.size();
+        while (kadj[cur].size() == 2) {
+          const auto& nx = (kadj[cur][0].second == id) ? kadj[cur][1] : kadj[cur][0];
+          cur = nx.first;
+          id = nx.second;
+          path[id] = (int)ends.size();
+        }
+        ends.push_back({v, cur});
+      }
+    }
+
+    // uncrossed edges of g on the paths
+    vector<pair<int,int>> cand; // (edge, path)
+    for (const BEdge& be : kuratowski) {
+      const int id = boost::get(boost::edge_index, b, be);
+      if (crossed[seg[id]] < 0) cand.push_back({seg[id], path[id]});
+    }
+    sort(cand.begin(), cand.end());
+    for (size_t i = 0; i < cand.size(); ++i) {
+      for (size_t j = i + 1; j < cand.size(); ++j) {
+        const auto& p = ends[cand[i].second];
+        const auto& q = ends[cand[j].second];
+        if (p.first == q.first || p.first == q.second || p.second == q.first || p.second == q.second) continue;
+        const auto& e = edge[cand[i].first];
+        const auto& f = edge[cand[j].first];
+        if (e.first == f.first || e.first == f.second || e.second == f.first || e.second == f.second) continue;
+        vector<pair<int,int>> k = cross;
+        k.push_back({cand[i].first, cand[j].first});
+        sort(k.begin(), k.end());
+        if (!seen.insert(k).second) continue;
+        add_crossing(cand[i].first, cand[j].first);
+        if (search(limit)) return true;
+        crossed[cand[i].first] = crossed[cand[j].first] = -1;
+        cross.pop_back();
+      }
+    }
+    return false;
+  }
+
+  bool run() {
+    if (g.n >= 3 && g.edges() > 4 * g.n - 8) return false;
+    // try the crossings g comes with (those of its parent) as they are, they
+    // mostly still work; otherwise search from a crossing-free drawing
+    if (!g.cross.empty()) {
+      for (const auto& q : g.cross) add_crossing(index[q[0] * g.n + q[1]], index[q[2] * g.n + q[3]]);
+      if (planar()) return true;
+      cross.clear();
+      crossed.assign(edge.size(), -1);
+    }
+    // iterative deepening on the number of crossings (at most n - 2 in a 1-planar graph)
+    for (size_t limit = 0; limit + 2 <= (size_t)max(g.n, 2); ++limit) {
+      seen.clear();
+      if (search(limit)) return true;
+    }
+    return false;
+  }
+
+  // the crossings found by run()
+  vector<array<int,4>> crossings() const {
+    vector<array<int,4>> out;
+    for (const auto& x : cross)
+      out.push_back({edge[x.first].first, edge[x.first].second, edge[x.second].first, edge[x.second].second});
+    return out;
+  }
+
+  // the 1-plane embedding found by run(), in the format of embedding.h; crossings
+  // whose edges only touch in the embedding are dropped and the test is redone
+  string embedding() {
+    for (;;) {
+      vector<int> seg;
+      BGraph b = planarization(seg);
+      typedef vector<vector<BEdge>> Storage;
+      Storage storage(boost::num_vertices(b));
+      boost::iterator_property_map<Storage::iterator, boost::property_map<BGraph, boost::vertex_index_t>::type>
+        emb(storage.begin(), boost::get(boost::vertex_index, b));
+      boost::boyer_myrvold_planarity_test(boost::boyer_myrvold_params::graph = b,
+                                          boost::boyer_myrvold_params::embedding = emb);
+      auto other = [&](int v, const BEdge& be) {
+        const int s = (int)boost::source(be, b), t = (int)boost::target(be, b);
+        return s == v ? t : s;
+      };
+      // the endpoint of g behind a neighbour of v in the planarization
+      auto real = [&](int v, int w) {
+        if (w < g.n) return w;
+        const auto& x = cross[w - g.n];
+        for (int e : {x.first, x.second}) {
+          if (edge[e].first == v) return edge[e].second;
+          if (edge[e].second == v) return edge[e].first;
+        }
+        return -1;
+      };
+      size_t touching = cross.size();
+      vector<array<int,4>> quad(cross.size());
+      for (size_t x = 0; x < cross.size() && touching == cross.size(); ++x) {
+        const int d = g.n + (int)x;
+        for (int k = 0; k < 4; ++k) quad[x][k] = other(d, storage[d][k]);
+        const auto& e = edge[cross[x].first];
+        const bool a0 = quad[x][0] == e.first || quad[x][0] == e.second;
+        const bool a2 = quad[x][2] == e.first || quad[x][2] == e.second;
+        if (a0 != a2) touching = x;
+      }
+      if (touching < cross.size()) {
+        crossed[cross[touching].first] = crossed[cross[touching].second] = -1;
+        cross.erase(cross.begin() + touching);
+        for (size_t x = 0; x < cross.size(); ++x) crossed[cross[x].first] = crossed[cross[x].second] = (int)x;
+        continue;
+      }
+      ostringstream out;
+      out << "n " << g.n << "\n";
+      for (int v = 0; v < g.n; ++v) {
+        out << v << ":";
+        for (const BEdge& be : storage[v]) out << " " << real(v, other(v, be));
+        out << "\n";
+      }
+      for (const auto& q : quad) out << "x " << q[0] << " " << q[1] << " " << q[2] << " " << q[3] << "\n";
+      return out.str();
+    }
+  }
+};
+
+//// Generation
+struct Stats {
+  vector<long long> count;
+  vector<int> max_edges;
+  vector<Graph> extremal;
+
+  explicit Stats(int maxn) : count(maxn + 1, 0), max_edges(maxn + 1, -1), extremal(maxn + 1) {}
+  void add(const Graph& g) {
+    ++count[g.n];
+    if (g.edges() > max_edges[g.n]) { max_edges[g.n] = g.edges(); extremal[g.n] = g; }
+  }
+  void merge(const Stats& o) {
+    for (size_t n = 0; n < count.size(); ++n) {
+      count[n] += o.count[n];
+      if (o.max_edges[n] > max_edges[n]) { max_edges[n] = o.max_edges[n]; extremal[n] = o.extremal[n]; }
+    }
+  }
+};
+
+struct Generator {
+  int maxn;
+  bool c4_only;
+
+  // all accepted children of g (graphs on g.n + 1 vertices)
+  vector<Graph> children(const Graph& g) const {
+    vector<Graph> out;
+    set<vector<Set>> keys;
+    const int n = g.n;
+    int mindeg = MAXN;
+    for (int v = 0; v < n; ++v) mindeg = min(mindeg, g.degree(v));
+
+    // neighbourhoods N of the new vertex: no two vertices of N have a common
+    // neighbour (no C4 through the new vertex), and the new vertex has minimum degree
+    vector<int> nb;
+    Set covered = 0; // vertices adjacent to some chosen neighbour
+    auto visit = [&](auto&& self, int from) -> void {
+      const int k = (int)nb.size();
+      bool ok = true;
+      for (int v = 0; v < n && ok; ++v) {
+        const bool in = find(nb.begin(), nb.end(), v) != nb.end();
+        ok = g.degree(v) + in >= k;
+      }
+      if (ok) try_child(g, nb, keys, out);
+      for (int v = from; v < n; ++v) {
+        if (k + 1 > mindeg + 1) break;
+        if (g.adj[v] & covered) continue; // v shares a neighbour with N
+        const Set old = covered;
+        nb.push_back(v);
+        covered |= g.adj[v];
+        self(self, v + 1);
+        nb.pop_back();
+        covered = old;
+      }
+    };
+    visit(visit, 0);
+    return out;
+  }
+
+  void try_child(const Graph& g, const vector<int>& nb, set<vector<Set>>& keys, vector<Graph>& out) const {
+    Graph h = g;
+    const int v = g.n;
+    h.n = g.n + 1;
+    for (int u : nb) { h.adj[u] |= Set(1) << v; h.adj[v] |= Set(1) << u; }
+
+    // canonical deletion: the vertex of minimum degree with the largest label
+    Canon c = Canonizer(h).run(vector<int>(h.n, 0));
+    int mindeg = MAXN;
+    for (int u = 0; u < h.n; ++u) mindeg = min(mindeg, h.degree(u));
+    int del = -1;
+    for (int i = h.n - 1; i >= 0 && del < 0; --i)
+      if (h.degree(c.lab[i]) == mindeg) del = c.lab[i];
+    if (c.orbit[del] != c.orbit[v]) return;
+    if (!keys.insert(c.key).second) return;
+    if (!c4_only) {
+      OnePlanarity op(h);
+      if (!op.run()) return;
+      h.cross = op.crossings();
+    }
+    out.push_back(h);
+  }
+
+  void dfs(const Graph& g, Stats& st) const {
+    st.add(g);
+    if (g.n == maxn) return;
+    for (const Graph& h : children(g)) dfs(h, st);
+  }
+};
+
+int main(int argc, char** argv) {
+  int maxn = -1, split = -1;
+  unsigned threads = max(1u, thread::hardware_concurrency());
+  bool embed = false, c4_only = false;
+  for (int i = 1; i < argc; ++i) {
+    const string a = argv[i];
+    if (a == "-j" && i + 1 < argc) threads = max(1, atoi(argv[++i]));
+    else if (a == "--split" && i + 1 < argc) split = atoi(argv[++i]);
+    else if (a == "--embed") embed = true;
+    else if (a == "--c4-only") c4_only = true;
+    else maxn = atoi(a.c_str());
+  }
+  if (maxn < 1 || maxn > MAXN) {
+    cerr << "usage: gen_c4free [-j threads] [--split level] [--embed] [--c4-only] maxn (1.." << MAXN << ")\n";
+    return 1;
+  }
+  if (split < 1 || split > maxn) split = max(1, maxn - 2);
+
+  Generator gen{maxn, c4_only};
+  Stats total(maxn);
+
+  // sequential part up to the split level
+  vector<Graph> level = {Graph()};
+  level[0].n = 1;
+  while (level[0].n < split) {
+    vector<Graph> next;
+    for (const Graph& g : level) {
+      total.add(g);
+      for (const Graph& h : gen.children(g)) next.push_back(h);
+    }
+    level.swap(next);
+  }
+
+  // subtrees below the split level in parallel
+  atomic<size_t> next_root(0);
+  vector<Stats> part(threads, Stats(maxn));
+  vector<thread> pool;
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      for (size_t k; (k = next_root++) < level.size(); ) gen.dfs(level[k], part[t]);
+    });
+  }
+  for (auto& th : pool) th.join();
+  for (const Stats& s : part) total.merge(s);
+
+  // as comments, so that the output with --embed can be fed to census
+  cout << (c4_only ? "# C4-free graphs\n" : "# C4-free 1-planar graphs\n");
+  cout << "#  n  graphs  max|E|  max|E|/n\n";
+  for (int n = 1; n <= maxn; ++n) {
+    cout << "# " << (n < 10 ? " " : "") << n << "  " << total.count[n] << "  " << total.max_edges[n]
+         << "  " << double(total.max_edges[n]) / n << "\n";
+  }
+  if (embed && !c4_only) {
+    for (int n = 1; n <= maxn; ++n) {
+      cout << "\n# extremal graph, " << total.max_edges[n] << " edges\n";
+      OnePlanarity op(total.extremal[n]);
+      op.run();
+      cout << op.embedding();
+    }
+  }
+}
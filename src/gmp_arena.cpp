@@ -0,0 +1,222 @@
+#include "gmp_arena.h"
+
+#include <gmp.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t grain = 16;                 // alignment and size-class step
+constexpr std::size_t largest_block = 4096;       // larger requests go to the heap
+constexpr std::size_t classes = largest_block / grain + 1;
+constexpr std::size_t first_chunk = 64 * 1024;
+constexpr std::size_t max_chunk = 1024 * 1024;
+
+// the memory functions the arena falls back to
+void* (*heap_alloc)(std::size_t);
+void* (*heap_realloc)(void*, std::size_t, std::size_t);
+void (*heap_free)(void*, std::size_t);
+
+std::size_t rounded(std::size_t bytes)
+{
+  return bytes == 0 ? grain : (bytes + grain - 1) / grain * grain;
+}
+
+struct Chunk {
+  char* begin;
+  std::size_t size;
+};
+
+struct Arena {
+  std::vector<Chunk> chunks;
+  char* top = nullptr;
+  char* end = nullptr;
+  void* free_list[classes] = {};
+  bool allocating = false;
+  Gmp_arena_stats stats;
+
+  bool owns(const void* p) const
+  {
+    const char* c = static_cast<const char*>(p);
+    for (const Chunk& k : chunks)
+      if (c >= k.begin && c < k.begin + k.size) return true;
+    return false;
+  }
+
+  void* bump(std::size_t size)
+  {
+    if ((std::size_t)(end - top) < size) {
+      const std::size_t want = chunks.empty() ? first_chunk : std::min(max_chunk, 2 * chunks.back().size);
+      char* c = static_cast<char*>(std::malloc(want));
+      if (c == nullptr) return nullptr;
+      chunks.push_back({ c, want });
+      top = c;
+      end = c + want;
+      stats.chunk_bytes += want;
+    }
+    void* p = top;
+    top += size;
+    return p;
+  }
+
+  void* allocate(std::size_t bytes)
+  {
+    const std::size_t size = rounded(bytes);
+    void*& head = free_list[size / grain];
+    ++stats.allocations;
+    stats.bytes += size;
+    if (head != nullptr) {
+      void* p = head;
+      head = *static_cast<void**>(p);
+      ++stats.reused;
+      return p;
+    }
+    return bump(size);
+  }
+
+  void release(void* p, std::size_t bytes)
+  {
+    const std::size_t size = rounded(bytes);
+    ++stats.frees;
+    if (static_cast<char*>(p) + size == top) { top = static_cast<char*>(p); return; }
+    void*& head = free_list[size / grain];
+    *static_cast<void**>(p) = head;
+    head = p;
+  }
+
+  // back to empty, keeping the first chunk
+  void reset()
+  {
+    for (std::size_t k = 1; k < chunks.size(); ++k) std::free(chunks[k].begin);
+    if (chunks.size() > 1) chunks.erase(chunks.begin() + 1, chunks.end());
+    top = chunks.empty() ? nullptr : chunks[0].begin;
+    end = chunks.empty() ? nullptr : chunks[0].begin + chunks[0].size;
+    std::fill(free_list, free_list + classes, nullptr);
+    allocating = false;
+    stats = Gmp_arena_stats();
+    if (!chunks.empty()) stats.chunk_bytes = chunks[0].size;
+  }
+
+  ~Arena()
+  {
+    for (const Chunk& k : chunks) std::free(k.begin);
+  }
+};
+
+// the arena of this thread, and whether a Gmp_arena is using it
+thread_local Arena arena;
+thread_local bool in_use = false;
+
+void note(std::size_t bytes)
+{
+  if (in_use) arena.stats.largest = std::max(arena.stats.largest, bytes);
+}
+
+void* arena_alloc(std::size_t bytes)
+{
+  note(bytes);
+  if (in_use && arena.allocating) {
+    if (bytes <= largest_block) {
+      void* p = arena.allocate(bytes);
+      if (p != nullptr) return p;
+    }
+    else ++arena.stats.large;
+  }
+  return heap_alloc(bytes);
+}
+
+void* arena_realloc(void* p, std::size_t old_bytes, std::size_t bytes)
+{
+  note(bytes);
+  if (!in_use || !arena.owns(p)) return heap_realloc(p, old_bytes, bytes);
+  ++arena.stats.reallocations;
+  const std::size_t old_size = rounded(old_bytes), size = rounded(bytes);
+  if (size <= old_size) { ++arena.stats.in_place; return p; }
+  char* c = static_cast<char*>(p);
+  if (arena.allocating && c + old_size == arena.top && size <= largest_block
+      && (std::size_t)(arena.end - c) >= size) {
+    arena.top = c + size;
+    arena.stats.bytes += size - std::min(size, old_size);
+    ++arena.stats.in_place;
+    return p;
+  }
+  void* q = arena_alloc(bytes);
+  std::memcpy(q, p, std::min(old_bytes, bytes));
+  arena.release(p, old_bytes);
+  return q;
+}
+
+void arena_free(void* p, std::size_t bytes)
+{
+  if (in_use && arena.owns(p)) arena.release(p, bytes);
+  else heap_free(p, bytes);
+}
+
+void install()
+{
+  static std::once_flag once;
+  std::call_once(once, [] {
+    mp_get_memory_functions(&heap_alloc, &heap_realloc, &heap_free);
+    mp_set_memory_functions(arena_alloc, arena_realloc, arena_free);
+  });
+}
+
+} // namespace
+
+void Gmp_arena_stats::add(const Gmp_arena_stats& o)
+{
+  sessions += o.sessions;
+  allocations += o.allocations;
+  reused += o.reused;
+  reallocations += o.reallocations;
+  in_place += o.in_place;
+  frees += o.frees;
+  large += o.large;
+  bytes += o.bytes;
+  chunk_bytes = std::max(chunk_bytes, o.chunk_bytes);
+  largest = std::max(largest, o.largest);
+}
+
+Gmp_arena::Gmp_arena(bool on, Gmp_arena_stats* out) : active_(on && !in_use), out(out)
+{
+  if (!active_) return;
+  install();
+  arena.reset();
+  arena.allocating = true;
+  in_use = true;
+}
+
+void Gmp_arena::stop()
+{
+  if (active_) arena.allocating = false;
+}
+
+Gmp_arena::~Gmp_arena()
+{
+  if (!active_) return;
+  in_use = false;
+  arena.stats.sessions = 1;
+  if (out != nullptr) out->add(arena.stats);
+  arena.reset();
+}
+
+bool gmp_arena_requested()
+{
+  const char* e = std::getenv("LP_GMP_ARENA");
+  if (e == nullptr || std::strcmp(e, "0") == 0) return false;
+  install();
+  return true;
+}
+
+CGAL::Gmpz detach(const CGAL::Gmpz& x)
+{
+  return CGAL::Gmpz(x.mpz());
+}
+
+CGAL::Gmpq detach(const CGAL::Gmpq& x)
+{
+  return CGAL::Gmpq(detach(x.numerator()), detach(x.denominator()));
+}
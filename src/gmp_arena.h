@@ -0,0 +1,80 @@
+// Arena memory for the GMP numbers of a solve.
+//
+// An exact solve makes and drops a great many small GMP numbers, each one a
+// malloc and a free. While a Gmp_arena is alive on a thread, GMP's memory
+// functions serve that thread's requests of up to 4 KiB from a bump arena
+// instead: requests are rounded up to a multiple of 16 bytes, freed blocks go
+// onto a free list per size class and are handed out again first, and
+// reallocation at the top of the arena grows in place. Larger requests, other
+// threads and frees of blocks that did not come from the arena go to the
+// previous memory functions (those of telemetry.h, if it installed its hooks
+// first, chain the same way). Destroying the Gmp_arena releases all of it at
+// once; the first chunk is kept for the next arena on the thread.
+//
+//   Gmp_arena_stats st;
+//   {
+//     Gmp_arena arena(true, &st);
+//     const Solution s = solve_lp(lp);
+//     ... use s ...
+//     arena.stop();              // what is allocated from here on goes to the heap
+//     keep = detach(value_of_s); // a deep copy that outlives the arena
+//   }                            // s is gone; the arena is released
+//
+// Nothing allocated in an arena may outlive it or be freed on another thread;
+// results are copied out with detach() after stop(). CGAL's Gmpz and Gmpq are
+// reference counted, so a plain copy shares the arena's limbs.
+//
+// Arenas are opt-in: the environment variable LP_GMP_ARENA turns them on in the
+// tools that solve many programs (intlp), Density_options::arena in the API.
+#ifndef GMP_ARENA_H
+#define GMP_ARENA_H
+
+#include <CGAL/Gmpq.h>
+#include <CGAL/Gmpz.h>
+
+#include <cstddef>
+
+struct Gmp_arena_stats {
+  long long sessions = 0;       // arenas released
+  long long allocations = 0;    // requests the arenas served
+  long long reused = 0;         // of those, from a free list
+  long long reallocations = 0;  // of arena blocks
+  long long in_place = 0;       // of those, kept or grown in place
+  long long frees = 0;          // of arena blocks
+  long long large = 0;          // requests over 4 KiB, passed to the heap
+  std::size_t bytes = 0;        // requested from the arenas, rounded up
+  std::size_t chunk_bytes = 0;  // the most one arena took from the heap
+  std::size_t largest = 0;      // the largest request of any size, in bytes
+
+  void add(const Gmp_arena_stats& o);
+};
+
+class Gmp_arena {
+public:
+  // with on false, or while another Gmp_arena is active on this thread, the
+  // arena does nothing; out (optional) gets the statistics added on release
+  explicit Gmp_arena(bool on = true, Gmp_arena_stats* out = nullptr);
+  ~Gmp_arena();
+  Gmp_arena(const Gmp_arena&) = delete;
+  Gmp_arena& operator=(const Gmp_arena&) = delete;
+
+  // later requests on this thread go to the heap; frees of arena blocks are
+  // still recognized until the arena is destroyed
+  void stop();
+
+  bool active() const { return active_; }
+
+private:
+  bool active_;
+  Gmp_arena_stats* out;
+};
+
+// true if LP_GMP_ARENA is set in the environment (and not "0"); installs the
+// memory functions then. Call it before starting threads that use GMP.
+bool gmp_arena_requested();
+
+// copies with limbs of their own, for results that outlive an arena
+CGAL::Gmpz detach(const CGAL::Gmpz& x);
+CGAL::Gmpq detach(const CGAL::Gmpq& x);
+
+#endif
@@ -0,0 +1,218 @@
+// Exact finite-n extremal counts: branch and bound on a formulation with the
+// normalization n-2=factor replaced by a fixed number of vertices and every
+// variable (they are all counts) required to be an integer.
+//
+//   intlp [--model basic|extended|no8|full] [-j threads] [--nodes limit] [-v] nmin nmax
+//
+// The values of n are solved in parallel, one branch and bound per thread.
+// The normalized LP relaxation is solved once; its bound E <= K (n-2) caps every
+// n before the search starts (the search stops as soon as an integral point
+// reaches it), and each node is pruned with the floor of its own LP value.
+// With -v the counts of an optimal integral point are printed for each n.
+// With LP_GMP_ARENA set in the environment every node solves in a GMP arena of
+// its thread (gmp_arena.h); the telemetry record then has the arena statistics.
+#include "gmp_arena.h"
+#include "lp_solve.h"
+#include "telemetry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// floor of num/den
+ET floor_div(ET num, ET den)
+{
+  if (den < 0) { num = -num; den = -den; }
+  ET q = num / den;
+  if (num % den != 0 && num < 0) q -= ET(1);
+  return q;
+}
+
+// bounds of the variables at a node; hi < 0 means no upper bound
+struct Node {
+  std::vector<int> lo, hi;
+};
+
+struct Result {
+  long long best = -1;   // largest integral E found, -1 if none
+  long long bound = -1;  // proven upper bound on E
+  long long nodes = 0;
+  bool unbounded = false;
+  std::vector<ET> point; // an optimal integral point
+  Gmp_arena_stats arena;
+};
+
+// maximizes E over the integral points of m with the given number of vertices
+Result branch_and_bound(const Model& m, int nverts, long long cap, long long limit, bool arena, Telemetry& tel)
+{
+  const int cols = m.lp.get_n();
+  Program base = m.lp;
+  base.set_b(m.norm_row, nverts);
+
+  Result res;
+  std::vector<Node> stack(1);
+  stack[0].lo.assign(cols, 0);
+  stack[0].hi.assign(cols, -1);
+  bool stopped = false; // node limit reached with nodes left open
+  while (!stack.empty() && res.best < cap) {
+    Node node = std::move(stack.back());
+    stack.pop_back();
+    if (res.nodes == limit) {
+      stopped = true;
+      break;
+    }
+    ++res.nodes;
+
+    // the GMP numbers of the node live and die in the arena
+    Gmp_arena node_arena(arena, &res.arena);
+    Program lp = base;
+    for (int j = 0; j < cols; ++j) {
+      if (node.lo[j] > 0) lp.set_l(j, true, node.lo[j]);
+      if (node.hi[j] >= 0) lp.set_u(j, true, node.hi[j]);
+    }
+    Solution s = solve_lp(lp);
+    tel.solved(s);
+    if (s.is_unbounded()) {
+      res.unbounded = true;
+      return res;
+    }
+    if (!s.is_optimal()) continue;
+
+    // E is an integer, so the node is only useful if floor(LP) beats the incumbent
+    const ET value = floor_div(-s.objective_value().numerator(), s.objective_value().denominator());
+    const long long bound = std::min(cap, (long long)CGAL::to_double(value));
+    if (bound <= res.best) continue;
+
+    // branch on the most fractional variable, i.e. the largest dist/den where
+    // dist is the distance of the value to the nearest integer
+    int br = -1;
+    bool up_first = false;
+    ET br_dist(0), br_den(1);
+    std::vector<ET> point;
+    for (auto it = s.variable_values_begin(); it != s.variable_values_end(); ++it) {
+      ET num = it->numerator(), den = it->denominator();
+      if (den < 0) { num = -num; den = -den; }
+      point.push_back(floor_div(num, den));
+      const ET r = num - point.back() * den;
+      if (r == 0) continue;
+      const ET dist = r * ET(2) > den ? den - r : r;
+      if (br < 0 || dist * br_den > br_dist * den) {
+        br = (int)point.size() - 1;
+        br_dist = dist;
+        br_den = den;
+        up_first = r * ET(2) >= den;
+      }
+    }
+    if (br < 0) {
+      res.best = bound;
+      node_arena.stop();
+      res.point.clear();
+      for (const ET& x : point) res.point.push_back(ET(detach(CGAL::Gmpz(x))));
+      continue;
+    }
+
+    // x_br <= floor and x_br >= floor + 1; the nearer side is searched first
+    Node down = node, up = std::move(node);
+    down.hi[br] = (int)CGAL::to_double(point[br]);
+    up.lo[br] = down.hi[br] + 1;
+    if (up_first) { stack.push_back(std::move(down)); stack.push_back(std::move(up)); }
+    else { stack.push_back(std::move(up)); stack.push_back(std::move(down)); }
+  }
+  res.bound = (stopped && res.best < cap) ? cap : res.best;
+  return res;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset = "basic";
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  long long limit = 100000;
+  bool verbose = false;
+  std::vector<int> range;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "-j" && i + 1 < argc) threads = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--nodes" && i + 1 < argc) limit = std::max(1LL, std::atoll(argv[++i]));
+    else if (a == "-v") verbose = true;
+    else range.push_back(std::atoi(a.c_str()));
+  }
+  if (range.size() != 2 || range[0] < 3 || range[1] < range[0]) {
+    std::cerr << "usage: intlp [--model basic|extended|no8|full] [-j threads] [--nodes limit] [-v] nmin nmax\n"
+                 "       (3 <= nmin <= nmax)\n";
+    return 1;
+  }
+
+  const bool arena = gmp_arena_requested();
+  Telemetry tel("intlp", preset);
+  tel.begin("build");
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  if (m.norm_row < 0) {
+    std::cerr << "model " << preset << " has no normalization row\n";
+    return 1;
+  }
+
+  tel.model(m);
+
+  // the LP relaxation: E <= K (n-2) with K = value/factor
+  tel.begin("relaxation");
+  Solution s = solve_lp(m.lp);
+  tel.solved(s);
+  if (!s.is_optimal()) {
+    std::cout << "the LP relaxation is not bounded and feasible\n";
+    return 1;
+  }
+  const ET K_num = -s.objective_value().numerator();
+  const ET K_den = s.objective_value().denominator() * ET((int)m.factor);
+  std::cout << "LP relaxation: |E| leq " << -(s.objective_value() / m.factor) << "n\n";
+
+  tel.begin("search");
+  const int count = range[1] - range[0] + 1;
+  std::vector<Result> results(count);
+  std::atomic<int> next(0);
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < std::min<unsigned>(threads, count); ++t) {
+    pool.emplace_back([&]() {
+      for (int k; (k = next++) < count;) {
+        const int nv = range[0] + k;
+        const long long cap = (long long)CGAL::to_double(floor_div(K_num * ET(nv - 2), K_den));
+        results[k] = branch_and_bound(m, nv, cap, limit, arena, tel);
+        tel.count("nodes", results[k].nodes);
+        tel.arena(results[k].arena);
+      }
+    });
+  }
+  for (std::thread& t : pool) t.join();
+  tel.begin("output");
+
+  std::cout << "\n   n   max E   LP bound   nodes\n";
+  for (int k = 0; k < count; ++k) {
+    const int nv = range[0] + k;
+    const Result& r = results[k];
+    const long long cap = (long long)CGAL::to_double(floor_div(K_num * ET(nv - 2), K_den));
+    std::ostringstream line;
+    line.width(4); line << nv << "   ";
+    line.width(5);
+    if (r.unbounded) line << "unbounded";
+    else if (r.best < 0 && r.bound < 0) line << "infeasible";
+    else if (r.best == r.bound) line << r.best;
+    else line << (std::to_string(r.best) + ".." + std::to_string(r.bound));
+    line << "   "; line.width(8); line << cap << "   " << r.nodes;
+    if (r.best != r.bound && !r.unbounded) line << " (node limit)";
+    std::cout << line.str() << "\n";
+    if (verbose && !r.point.empty()) {
+      for (std::size_t j = 0; j < r.point.size(); ++j)
+        if (r.point[j] != 0) std::cout << "        " << m.vname[j] << " = " << r.point[j] << "\n";
+    }
+  }
+}
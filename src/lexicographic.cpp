@@ -0,0 +1,178 @@
+#include "lexicographic.h"
+#include "presolve.h"
+
+#include <sstream>
+
+namespace {
+
+std::string trim(const std::string& s)
+{
+  const std::size_t a = s.find_first_not_of(" \t\r"), b = s.find_last_not_of(" \t\r");
+  return a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+bool parse_rational(const std::string& s, Rational& q)
+{
+  try {
+    std::size_t used = 0;
+    const std::size_t slash = s.find('/');
+    const long num = std::stol(s.substr(0, slash), &used);
+    if (used != (slash == std::string::npos ? s.size() : slash)) return false;
+    long den = 1;
+    if (slash != std::string::npos) {
+      den = std::stol(s.substr(slash + 1), &used);
+      if (used != s.size() - slash - 1 || den == 0) return false;
+    }
+    q = Rational(CGAL::Gmpz(num), CGAL::Gmpz(den));
+    return true;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+// the optimal face of r: variables with nonzero reduced cost fixed at the bound
+// they sit on, rows with a multiplier made equalities
+void restrict_to_face(Model& m, const Density_result& r, Lex_stage& s)
+{
+  Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  std::vector<Rational> l(rows, Rational(0));
+  for (const Named_value& v : r.multipliers) {
+    l[v.index] = v.value;
+    if (lp.get_r()[v.index] != CGAL::EQUAL) {
+      lp.set_r(v.index, CGAL::EQUAL);
+      ++s.equalities;
+    }
+  }
+  for (int j = 0; j < cols; ++j) {
+    const bool fixed = lp.get_fl()[j] && lp.get_fu()[j] && lp.get_l()[j] == lp.get_u()[j];
+    Rational d(lp.get_c()[j]);
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (l[i] != 0 && col[i] != 0) d += l[i] * Rational(col[i]);
+    if (fixed || d == 0) continue;
+    // verify_density() has checked that the bound exists
+    if (d > 0) lp.set_u(j, true, lp.get_l()[j]);
+    else lp.set_l(j, true, lp.get_u()[j]);
+    ++s.fixed;
+  }
+}
+
+} // namespace
+
+bool set_objective(Program& lp, const Lex_objective& o)
+{
+  std::vector<std::pair<int, Rational>> terms = o.terms;
+  if (o.maximize)
+    for (auto& t : terms) t.second = -t.second;
+  std::vector<IT> c;
+  IT zero;
+  if (!scale_row(terms, Rational(0), c, zero)) return false;
+  for (int j = 0; j < lp.get_n(); ++j) lp.set_c(j, 0);
+  for (std::size_t k = 0; k < terms.size(); ++k) lp.set_c(terms[k].first, c[k]);
+  return true;
+}
+
+bool parse_objective(const Model& m, const std::string& text, Lex_objective& o, std::string& error)
+{
+  o = Lex_objective();
+  o.text = trim(text);
+  const std::size_t sp = o.text.find(' ');
+  const std::string sense = o.text.substr(0, sp);
+  if (sense != "min" && sense != "max") {
+    error = "objective \"" + o.text + "\" does not start with min or max";
+    return false;
+  }
+  o.maximize = sense == "max";
+  std::istringstream in(sp == std::string::npos ? "" : o.text.substr(sp + 1));
+  std::string field;
+  while (std::getline(in, field, ';')) {
+    field = trim(field);
+    Rational c(1);
+    std::string name = field;
+    const std::size_t blank = field.find(' ');
+    if (blank != std::string::npos && parse_rational(field.substr(0, blank), c)) name = trim(field.substr(blank + 1));
+    else c = Rational(1);
+    int j = -1;
+    for (std::size_t k = 0; k < m.vname.size(); ++k)
+      if (m.vname[k] == name) j = (int)k;
+    if (j < 0) {
+      error = "no variable \"" + name + "\"";
+      return false;
+    }
+    o.terms.push_back({ j, c });
+  }
+  if (o.terms.empty()) {
+    error = "objective \"" + o.text + "\" has no terms";
+    return false;
+  }
+  std::vector<IT> c;
+  IT zero;
+  if (!scale_row(o.terms, Rational(0), c, zero)) {
+    error = "objective \"" + o.text + "\" does not fit int once its denominators are cleared";
+    return false;
+  }
+  return true;
+}
+
+Lex_result solve_lexicographic(const Model& m, const std::vector<Lex_objective>& sequence,
+                               const Density_options& options)
+{
+  Lex_result out;
+  Model& face = out.face;
+  face = m;
+  Density_result& r = out.result;
+  if (options.drop_density_row) {
+    if (face.density_row < 0) {
+      r.error = "the model has no density row to drop";
+      return out;
+    }
+    for (int j = 0; j < face.lp.get_n(); ++j) face.lp.set_a(j, face.density_row, 0);
+    face.lp.set_b(face.density_row, 0);
+  }
+  if (options.presolve) {
+    const Implied_bounds ib = implied_bounds(face);
+    if (!ib.infeasible.empty()) {
+      r.status = Density_status::infeasible;
+      r.error = "presolve: row \"" + ib.infeasible + "\" cannot be satisfied";
+      return out;
+    }
+    apply_bounds(face, ib);
+  }
+  Density_options o = options;
+  o.presolve = o.drop_density_row = false;
+  o.values = o.certificate = true;
+
+  Rational bound;
+  for (std::size_t k = 0; k <= sequence.size(); ++k) {
+    Lex_stage s;
+    s.objective = k == 0 ? "bound" : sequence[k - 1].text;
+    if (k > 0 && !set_objective(face.lp, sequence[k - 1])) {
+      r = Density_result();
+      r.error = "stage \"" + s.objective + "\": the objective does not fit int";
+      out.stages.push_back(s);
+      break;
+    }
+    r = solve_density(face, o);
+    s.pivots = r.pivots;
+    if (r.status == Density_status::optimal) {
+      const std::string err = verify_density(face, r);
+      if (!err.empty()) {
+        r.status = Density_status::error;
+        r.error = "stage \"" + s.objective + "\": " + err;
+      }
+    }
+    if (r.status != Density_status::optimal) {
+      out.stages.push_back(s);
+      break;
+    }
+    if (k == 0) s.value = bound = r.bound;
+    else
+      for (const auto& t : sequence[k - 1].terms) s.value += t.second * r.values[t.first].value;
+    r.bound = bound;
+    restrict_to_face(face, r, s);
+    out.stages.push_back(s);
+  }
+  return out;
+}
@@ -0,0 +1,67 @@
+// Lexicographic optimization: the bound first, then secondary objectives over
+// the optimal face, so that the extremal configuration a solve reports is the
+// same from run to run and not whichever optimal vertex the simplex hit.
+//
+//   std::vector<Lex_objective> seq(2);
+//   parse_objective(m, "min #crossings", seq[0], err);
+//   parse_objective(m, "max t6", seq[1], err);
+//   const Lex_result r = solve_lexicographic(m, seq);
+//
+// The model's own objective (maximize E) comes first. After each stage the
+// program is restricted to that stage's optimal face by complementary
+// slackness with its multipliers l: every variable with reduced cost
+// c_j + sum_i a_ij l_i > 0 is fixed at its lower bound (< 0: upper bound), and
+// every row with l_i != 0 becomes an equality. A point of the restricted
+// program is optimal for the stage, and every optimal point is in it, so the
+// next objective is optimized exactly over the optimal face. Each stage makes
+// the program smaller instead of adding a dense row "objective = optimum"
+// with large coefficients. (CGAL's solver cannot be started from a given
+// basis; the fixed columns are what keeps the later stages to a few pivots.)
+// Every stage is verified exactly with verify_density() on its restricted
+// program.
+#ifndef LEXICOGRAPHIC_H
+#define LEXICOGRAPHIC_H
+
+#include "density_lp.h"
+
+#include <string>
+#include <vector>
+
+// minimize or maximize sum_j a_j x_j
+struct Lex_objective {
+  std::string text;                           // as given to parse_objective
+  bool maximize = false;
+  std::vector<std::pair<int, Rational>> terms; // (variable, coefficient)
+};
+
+// "min <variable>" or "max <coef> <variable>; <coef> <variable>; ..." with
+// exact rational coefficients like -3/2 (1 if left out); returns false with
+// the reason in error, also if the coefficients do not fit IT once their
+// denominators are cleared
+bool parse_objective(const Model& m, const std::string& text, Lex_objective& o, std::string& error);
+
+// sets c to o (negated to maximize), cleared of denominators and divided by
+// the gcd of the numerators, as set_row() does with a row; returns false,
+// leaving lp unchanged, if a coefficient does not fit IT
+bool set_objective(Program& lp, const Lex_objective& o);
+
+struct Lex_stage {
+  std::string objective;     // "bound" for the model's own objective
+  Rational value;            // optimum of the stage (of sum_j a_j x_j, not negated)
+  int pivots = 0;
+  int fixed = 0, equalities = 0; // variables fixed and rows made equalities after the stage
+};
+
+struct Lex_result {
+  Density_result result;        // the last stage: values and multipliers; bound of the first
+  std::vector<Lex_stage> stages; // one per objective solved, the model's own first
+  Model face;                   // the program restricted to the final optimal face
+};
+
+// options.presolve and options.drop_density_row are applied to m once, before the
+// first stage; values and certificate are always computed. Stops at the first
+// stage that is not optimal (result.status says which).
+Lex_result solve_lexicographic(const Model& m, const std::vector<Lex_objective>& sequence,
+                               const Density_options& options = Density_options());
+
+#endif
@@ -0,0 +1,132 @@
+// Lexicographic optimization of a formulation (lexicographic.h): the bound,
+// then each objective over the optimal face of the ones before it, so the
+// extremal configuration printed is the same on every run.
+//
+//   lexopt [--model basic|extended|no8|full] [--presolve] [--compare] [-v] [objective...]
+//
+// An objective is "min <variable>" or "max <coef> <variable>; <coef> <variable>; ..."
+// (see parse_objective); without any, "min #crossings" and then "max t6".
+// Every stage prints its optimum, pivots and how much of the program it fixed;
+// -v prints the nonzero values of the final point. --compare solves the same
+// sequence cold, adding a row "objective = optimum" per stage to the original
+// program, and checks that every stage has the same optimum. An objective
+// whose coefficients do not fit int is rejected. Exit code 1 if a stage is not
+// optimal, does not verify or (with --compare) disagrees or does not fit int.
+#include "lexicographic.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+double ms_since(std::chrono::steady_clock::time_point t0)
+{
+  return 1000 * std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// the optimum of every stage, each added to the program as an equality before
+// the next; stops at the first stage that is not optimal, or with the reason in
+// error at one whose objective or row does not fit int
+std::vector<Rational> solve_cold(const Model& original, const std::vector<Lex_objective>& sequence,
+                                 const Density_options& options, int& pivots, std::string& error)
+{
+  std::vector<Rational> values;
+  Model m = original;
+  Lex_objective own;
+  own.text = "bound";
+  for (int j = 0; j < m.lp.get_n(); ++j)
+    if (m.lp.get_c()[j] != 0) own.terms.push_back({ j, Rational(m.lp.get_c()[j]) });
+  for (std::size_t k = 0; k <= sequence.size(); ++k) {
+    const Lex_objective& o = k == 0 ? own : sequence[k - 1];
+    if (k > 0 && !set_objective(m.lp, o)) {
+      error = "the objective of stage " + std::to_string(k) + " does not fit int";
+      break;
+    }
+    const Density_result r = solve_density(m, options);
+    pivots += r.pivots;
+    if (r.status != Density_status::optimal || !verify_density(m, r).empty()) break;
+    Rational v;
+    for (const auto& t : o.terms) v += t.second * r.values[t.first].value;
+    values.push_back(k == 0 ? r.bound : v);
+    if (k == sequence.size()) break;
+    const int i = m.lp.get_m();
+    if (!set_row(m.lp, i, CGAL::EQUAL, o.terms, v)) {
+      error = "the row fixing stage " + std::to_string(k) + " (" + o.text + ") does not fit int";
+      break;
+    }
+    m.cname.push_back("stage " + std::to_string(k) + ": " + o.text);
+  }
+  return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset = "extended";
+  bool compare = false, verbose = false;
+  Density_options options;
+  std::vector<std::string> texts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--presolve") options.presolve = true;
+    else if (a == "--compare") compare = true;
+    else if (a == "-v") verbose = true;
+    else if (a.compare(0, 4, "min ") == 0 || a.compare(0, 4, "max ") == 0) texts.push_back(a);
+    else {
+      std::cerr << "usage: lexopt [--model basic|extended|no8|full] [--presolve] [--compare] [-v] [objective...]\n";
+      return 1;
+    }
+  }
+  if (texts.empty()) texts = { "min #crossings", "max t6" };
+
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  std::vector<Lex_objective> sequence(texts.size());
+  for (std::size_t k = 0; k < texts.size(); ++k) {
+    std::string error;
+    if (!parse_objective(m, texts[k], sequence[k], error)) {
+      std::cerr << error << "\n";
+      return 1;
+    }
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  const Lex_result lex = solve_lexicographic(m, sequence, options);
+  const double lex_ms = ms_since(t0);
+  int lex_pivots = 0;
+  for (const Lex_stage& s : lex.stages) {
+    lex_pivots += s.pivots;
+    std::cout << s.objective << ": " << s.value << " (" << s.pivots << " pivots; then " << s.fixed
+              << " variables fixed, " << s.equalities << " rows made equalities)\n";
+  }
+  if (lex.result.status != Density_status::optimal) {
+    std::cout << "FAIL: " << (lex.result.error.empty() ? "not optimal" : lex.result.error) << "\n";
+    return 1;
+  }
+  std::cout << preset << ": |E| leq " << lex.result.bound << "n, " << lex.stages.size() << " stages, " << lex_pivots
+            << " pivots, " << lex_ms << " ms\n";
+  if (verbose)
+    for (const Named_value& v : lex.result.values)
+      if (v.value != 0) std::cout << "  " << v.name << " = " << v.value << "\n";
+
+  if (!compare) return 0;
+  int cold_pivots = 0;
+  t0 = std::chrono::steady_clock::now();
+  std::string error;
+  const std::vector<Rational> cold = solve_cold(m, sequence, options, cold_pivots, error);
+  const double cold_ms = ms_since(t0);
+  if (!error.empty()) {
+    std::cout << "FAIL: cold: " << error << "\n";
+    return 1;
+  }
+  bool same = cold.size() == lex.stages.size();
+  for (std::size_t k = 0; same && k < cold.size(); ++k) same = cold[k] == lex.stages[k].value;
+  std::cout << "cold, with a row per stage: " << cold_pivots << " pivots, " << cold_ms << " ms; "
+            << (same ? "same optima" : "DIFFERENT optima") << "\n";
+  return same ? 0 : 1;
+}
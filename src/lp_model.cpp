@@ -0,0 +1,69 @@
+#include "lp_model.h"
+
+#include <climits>
+#include <utility>
+
+bool build_model(const std::string& name, Model& m)
+{
+  if (name == "basic") build_basic(m);
+  else if (name == "extended") build_extended(m);
+  else if (name == "no8") build_no8(m);
+  else if (name == "full") build_full(m);
+  else return false;
+  return true;
+}
+
+bool scale_row(const std::vector<std::pair<int, Rational>>& a, const Rational& b, std::vector<IT>& ai, IT& bi)
+{
+  typedef CGAL::Gmpz Z;
+  // the smallest common denominator, then the gcd of the cleared numerators
+  Z den(1);
+  for (const auto& t : a) den = CGAL::integral_division(den, CGAL::gcd(den, t.second.denominator())) * t.second.denominator();
+  den = CGAL::integral_division(den, CGAL::gcd(den, b.denominator())) * b.denominator();
+  Z g(0);
+  auto scaled = [&](const Rational& q) { return CGAL::integral_division(q.numerator() * den, q.denominator()); };
+  for (const auto& t : a) g = CGAL::gcd(g, scaled(t.second));
+  g = CGAL::gcd(g, scaled(b));
+  if (g < 0) g = -g;
+  if (g == 0) g = Z(1);
+
+  bool fits = true;
+  auto to_it = [&](const Rational& q) {
+    const Z v = CGAL::integral_division(scaled(q), g);
+    if (v > Z(INT_MAX) || v < Z(INT_MIN)) { fits = false; return IT(0); }
+    return (IT)CGAL::to_double(v);
+  };
+  ai.clear();
+  for (const auto& t : a) ai.push_back(to_it(t.second));
+  bi = to_it(b);
+  return fits;
+}
+
+bool set_row(Program& lp, int i, CGAL::Comparison_result r,
+             const std::vector<std::pair<int, Rational>>& a, const Rational& b)
+{
+  std::vector<IT> ai;
+  IT bi;
+  if (!scale_row(a, b, ai, bi)) return false;
+  lp.set_r(i, r);
+  lp.set_b(i, bi);
+  for (std::size_t k = 0; k < a.size(); ++k) lp.set_a(a[k].first, i, ai[k]);
+  return true;
+}
+
+void add_swap(Model& m, int a, int b)
+{
+  std::vector<int> perm(m.vname.size());
+  for (std::size_t j = 0; j < perm.size(); ++j) perm[j] = (int)j;
+  std::swap(perm[a], perm[b]);
+  m.symmetry.push_back(perm);
+}
+
+std::string family(const std::string& v)
+{
+  if (v.compare(0, 13, "#num_vertices") == 0 || v.compare(0, 7, "degree ") == 0) return "vertices";
+  if (v == "#crossings" || v == "sx" || v.compare(0, 6, "wedge ") == 0) return "crossings";
+  if (v == "s1" || v == "s2" || v == "s3") return "corners";
+  if (v.find("edges") != std::string::npos) return "edges";
+  return "cells";
+}
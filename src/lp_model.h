@@ -0,0 +1,89 @@
+// Shared types for the edge density formulations
+#ifndef LP_MODEL_H
+#define LP_MODEL_H
+
+#include <CGAL/QP_models.h>
+#include <CGAL/Gmpz.h>
+#include <CGAL/Gmpq.h>
+#include <utility>
+#include <vector>
+#include <string>
+
+// choose input type (input coefficients must fit)
+typedef int IT;
+// choose exact type for solver (CGAL::Gmpz or CGAL::Gmpq); with
+// LP_SMALL_INT_ET (cmake -DLP_SMALL_INT_ET=ON) the 64-bit fast path of
+// small_int.h, which falls back to GMP on overflow
+#ifdef LP_SMALL_INT_ET
+#include "small_int.h"
+typedef Small_int ET;
+#else
+typedef CGAL::Gmpz ET;
+#endif
+// exact coefficients of a row before it is scaled to IT, see set_row
+typedef CGAL::Gmpq Rational;
+
+// program type
+typedef CGAL::Quadratic_program<IT> Program;
+// a program read from constant arrays (static_model.h)
+typedef CGAL::Linear_program_from_iterators<const IT* const*, const IT*, const CGAL::Comparison_result*,
+                                            const bool*, const IT*, const bool*, const IT*, const IT*>
+  Static_program;
+
+// a formulation: the program together with the names of its variables and rows
+struct Model {
+  Program lp;
+  std::vector<std::string> vname; // variables
+  std::vector<std::string> cname; // constraints
+  int norm_row;                   // the row n-2=factor
+  int density_row;                // the hand-chosen edge density formula
+  std::vector<std::vector<int>> symmetry; // generators: permutations of the variables, see symmetry.h
+  double factor;
+
+  // an LP with Ax <= b, lower bound 0 and no upper bounds on variables
+  Model() : lp(CGAL::SMALLER, true, 0, false, 1000), norm_row(-1), density_row(-1), factor(10.0) {}
+};
+
+// the formulations, see model_*.cpp
+void build_basic(Model& m);    // mainMin_basic.cpp
+void build_extended(Model& m); // mainMin_extended.cpp
+void build_no8(Model& m);      // main_no8.cpp
+void build_full(Model& m);     // main.cpp
+
+// the full formulation without building anything: CGAL reads the arrays the
+// compiler made from model_full.cpp
+Static_program full_program();
+
+// names of the variables and rows of a Static_program, and its factor
+struct Static_names {
+  const char* const* vname;
+  const char* const* cname;
+  double factor;
+};
+Static_names full_names();
+
+// build the formulation with the given name (basic, extended, no8, full);
+// returns false if there is no such formulation
+bool build_model(const std::string& name, Model& m);
+
+// sets row i of lp to  sum_j a_j x_j  r  b  with exact rational coefficients
+// (variable, coefficient); the row is multiplied by the lcm of the denominators
+// and divided by the gcd of the numerators, the smallest integer row with the
+// same solutions. Returns false, leaving lp unchanged, if a coefficient or b
+// does not fit IT after scaling.
+bool set_row(Program& lp, int i, CGAL::Comparison_result r,
+             const std::vector<std::pair<int, Rational>>& a, const Rational& b);
+
+// the scaling of set_row: ai (one per term of a) and bi; false if one of them
+// does not fit IT
+bool scale_row(const std::vector<std::pair<int, Rational>>& a, const Rational& b, std::vector<IT>& ai, IT& bi);
+
+// adds the symmetry swapping variables a and b to m.symmetry (call it once
+// all variables exist)
+void add_swap(Model& m, int a, int b);
+
+// what a variable counts, from its name: "cells", "crossings" (also wedges),
+// "corners", "vertices" (also vertex types) or "edges"
+std::string family(const std::string& vname);
+
+#endif
@@ -0,0 +1,12 @@
+#include "lp_solve.h"
+#include <CGAL/QP_functions.h>
+
+Solution solve_lp(const Program& lp, const CGAL::Quadratic_program_options& options)
+{
+  return CGAL::solve_linear_program(lp, ET(), options);
+}
+
+Solution solve_lp(const Static_program& lp, const CGAL::Quadratic_program_options& options)
+{
+  return CGAL::solve_linear_program(lp, ET(), options);
+}
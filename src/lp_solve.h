@@ -0,0 +1,21 @@
+// The exact solver for the formulations. CGAL's QP solver templates are
+// instantiated once, in lp_solve.cpp (library qp_solver); include this header
+// instead of <CGAL/QP_functions.h> so that editing a model or a tool does not
+// recompile them.
+#ifndef LP_SOLVE_H
+#define LP_SOLVE_H
+
+#include "lp_model.h"
+#include <CGAL/QP_options.h>
+#include <CGAL/QP_solution.h>
+
+// solution type
+typedef CGAL::Quadratic_program_solution<ET> Solution;
+
+// solves the linear program lp, using ET as the exact type
+Solution solve_lp(const Program& lp,
+                  const CGAL::Quadratic_program_options& options = CGAL::Quadratic_program_options());
+Solution solve_lp(const Static_program& lp,
+                  const CGAL::Quadratic_program_options& options = CGAL::Quadratic_program_options());
+
+#endif
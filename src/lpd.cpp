@@ -0,0 +1,459 @@
+// Resident solver: keeps a formulation, its presolved form and the last result
+// in memory and answers requests on a Unix domain socket, so trying a new lemma
+// costs one solve instead of a process start, a rebuild and a cold solve.
+//
+//   lpd --socket path [--model basic|extended|no8|full] [--presolve]
+//
+// One request per line, one JSON object per reply line ({"ok":false,"error":...}
+// on errors). Fields of a request are separated by ';', coefficients are exact
+// rationals like -15/7, relations are <=, = or >=:
+//   model <preset>                          start over from a preset
+//   reset                                   back to the preset, undoing all edits
+//   add <row>; <rel> <rhs>; <coef> <variable>; ...    add a row (scaled by set_row)
+//   remove <row>                            remove a row
+//   set <row>; <variable>; <coef>           change one coefficient of a row
+//   rhs <row>; <rhs>                        change the right-hand side of a row
+//   presolve on|off                         solve with the implied bounds of presolve.h
+//   solve                                   {"status","bound","pivots","ms","cached"}, and
+//                                           "reason" when presolve finds a row infeasible
+//   duals                                   multipliers of the last optimal solve
+//   values                                  nonzero values of the last solve
+//   rows                                    every row: name and "<rel> <rhs>; <coef> <variable>; ..."
+//   quit                                    close this connection
+//   shutdown                                stop the server
+// Rows are found by name; names made ambiguous by the formulation itself are
+// rejected. Coefficients and right-hand sides must fit IT, as entered and after
+// the row is scaled; an edit that does not is refused and changes nothing.
+// set and rhs work in the units a row was entered in: an added row keeps its
+// rational terms and right-hand side and is scaled again by set_row after
+// every edit, a row of the preset is in the integer form rows prints. A
+// removed row stays in the program as 0 = 0, so indices are stable.
+// Solving an unchanged program returns the last result ("cached":true), and the
+// presolved form is only recomputed after an edit. CGAL's solver cannot start
+// from a given basis, so every actual solve starts cold.
+// Clients are served one after another, e.g.  socat - UNIX-CONNECT:path
+#include "density_lp.h"
+#include "presolve.h"
+
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::string quote(const std::string& s)
+{
+  std::string q = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') q += '\\';
+    if (c == '\n') { q += "\\n"; continue; }
+    q += c;
+  }
+  return q + "\"";
+}
+
+std::string str(const Rational& q)
+{
+  std::ostringstream out;
+  out << q;
+  return out.str();
+}
+
+std::string trim(const std::string& s)
+{
+  const std::size_t a = s.find_first_not_of(" \t\r"), b = s.find_last_not_of(" \t\r");
+  return a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+std::vector<std::string> fields(const std::string& s)
+{
+  std::vector<std::string> out;
+  std::istringstream in(s);
+  std::string f;
+  while (std::getline(in, f, ';')) out.push_back(trim(f));
+  return out;
+}
+
+bool parse_rational(const std::string& s, Rational& q)
+{
+  try {
+    std::size_t used = 0;
+    const std::size_t slash = s.find('/');
+    const long num = std::stol(s.substr(0, slash), &used);
+    if (used != (slash == std::string::npos ? s.size() : slash)) return false;
+    long den = 1;
+    if (slash != std::string::npos) {
+      den = std::stol(s.substr(slash + 1), &used);
+      if (used != s.size() - slash - 1 || den == 0) return false;
+    }
+    q = Rational(CGAL::Gmpz(num), CGAL::Gmpz(den));
+    return true;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+// a coefficient or right-hand side as entered: numerator and denominator fit IT
+bool fits_it(const Rational& q)
+{
+  const CGAL::Gmpz lo(INT_MIN), hi(INT_MAX);
+  return q.numerator() >= lo && q.numerator() <= hi && q.denominator() <= hi;
+}
+
+std::string error(const std::string& what)
+{
+  return "{\"ok\":false,\"error\":" + quote(what) + "}";
+}
+
+class Server {
+public:
+  explicit Server(bool presolve) : presolve(presolve) {}
+
+  bool load(const std::string& name)
+  {
+    Model m;
+    if (!build_model(name, m)) return false;
+    preset = name;
+    base = m;
+    current = m;
+    removed.assign(m.lp.get_m(), false);
+    entered.clear();
+    for (int i = 0; i < m.lp.get_m(); ++i) entered.push_back({ terms(i), Rational(m.lp.get_b()[i]) });
+    changed();
+    return true;
+  }
+
+  // the reply to one request; sets stop on shutdown
+  std::string handle(const std::string& line, bool& close, bool& stop)
+  {
+    const std::size_t sp = line.find(' ');
+    const std::string cmd = line.substr(0, sp), rest = sp == std::string::npos ? "" : trim(line.substr(sp + 1));
+    if (cmd == "quit") { close = true; return "{\"ok\":true}"; }
+    if (cmd == "shutdown") { close = stop = true; return "{\"ok\":true}"; }
+    if (cmd == "model") {
+      if (!load(rest)) return error("unknown model " + rest + " (basic, extended, no8, full)");
+      return "{\"ok\":true,\"model\":" + quote(preset) + ",\"rows\":" + std::to_string(current.lp.get_m())
+             + ",\"columns\":" + std::to_string(current.lp.get_n()) + "}";
+    }
+    if (cmd == "reset") return load(preset) ? "{\"ok\":true}" : error("no model");
+    if (cmd == "presolve") {
+      if (rest != "on" && rest != "off") return error("presolve on|off");
+      if (presolve != (rest == "on")) { presolve = rest == "on"; solved = false; }
+      return "{\"ok\":true}";
+    }
+    if (cmd == "add") return add(fields(rest));
+    if (cmd == "remove") return remove(rest);
+    if (cmd == "set") return set(fields(rest));
+    if (cmd == "rhs") return rhs(fields(rest));
+    if (cmd == "solve") return solve();
+    if (cmd == "duals") return listing(last.multipliers, "duals");
+    if (cmd == "values") return listing(last.values, "values");
+    if (cmd == "rows") {
+      std::string out = "{\"ok\":true,\"rows\":[";
+      bool first = true;
+      for (std::size_t i = 0; i < current.cname.size(); ++i) {
+        if (removed[i]) continue;
+        out += std::string(first ? "" : ",") + "{\"name\":" + quote(current.cname[i]) + ",\"row\":" + quote(text((int)i)) + "}";
+        first = false;
+      }
+      return out + "]}";
+    }
+    return error("unknown request " + quote(cmd));
+  }
+
+private:
+  // a row as it was entered, before set_row scaled it
+  struct Entered_row {
+    std::vector<std::pair<int, Rational>> terms;
+    Rational b;
+  };
+
+  std::string preset;
+  Model base, current, presolved;
+  std::vector<bool> removed;
+  std::vector<Entered_row> entered;
+  bool presolve;
+  bool presolved_valid = false, solved = false;
+  Density_result last;
+  double last_ms = 0;
+
+  void changed() { presolved_valid = solved = false; }
+
+  // the row called name, -1 if there is none, -2 if there are several
+  int row(const std::string& name) const
+  {
+    int found = -1;
+    for (std::size_t i = 0; i < current.cname.size(); ++i) {
+      if (removed[i] || current.cname[i] != name) continue;
+      if (found >= 0) return -2;
+      found = (int)i;
+    }
+    return found;
+  }
+
+  int variable(const std::string& name) const
+  {
+    for (std::size_t j = 0; j < current.vname.size(); ++j)
+      if (current.vname[j] == name) return (int)j;
+    return -1;
+  }
+
+  std::string row_error(const std::string& name, int i) const
+  {
+    return error(i == -2 ? "row name " + quote(name) + " is ambiguous" : "no row " + quote(name));
+  }
+
+  // the stored (scaled) row as rationals
+  std::vector<std::pair<int, Rational>> terms(int i) const
+  {
+    std::vector<std::pair<int, Rational>> t;
+    for (int j = 0; j < current.lp.get_n(); ++j) {
+      const IT a = current.lp.get_a()[j][i];
+      if (a != 0) t.push_back({ j, Rational(a) });
+    }
+    return t;
+  }
+
+  // row i as entered, in the syntax of add
+  std::string text(int i) const
+  {
+    const CGAL::Comparison_result r = current.lp.get_r()[i];
+    std::string out = (r == CGAL::SMALLER ? "<= " : r == CGAL::EQUAL ? "= " : ">= ") + str(entered[i].b);
+    for (const auto& t : entered[i].terms)
+      if (t.second != 0) out += "; " + str(t.second) + " " + current.vname[t.first];
+    return out;
+  }
+
+  // scales the entered form of row i into the program again; false, leaving
+  // the program alone, if the scaled row does not fit IT
+  bool rescale(int i)
+  {
+    std::vector<IT> a;
+    IT b;
+    if (!scale_row(entered[i].terms, entered[i].b, a, b)) return false;
+    for (int j = 0; j < current.lp.get_n(); ++j) current.lp.set_a(j, i, 0);
+    set_row(current.lp, i, current.lp.get_r()[i], entered[i].terms, entered[i].b);
+    return true;
+  }
+
+  static std::string too_large() { return error("a coefficient or the right-hand side does not fit IT (after scaling)"); }
+
+  std::string add(const std::vector<std::string>& f)
+  {
+    if (f.size() < 3) return error("add <row>; <rel> <rhs>; <coef> <variable>; ...");
+    if (f[0].empty() || row(f[0]) != -1) return error("row name " + quote(f[0]) + " is empty or taken");
+    std::istringstream rel_rhs(f[1]);
+    std::string rel, b;
+    rel_rhs >> rel >> b;
+    CGAL::Comparison_result r;
+    if (rel == "<=") r = CGAL::SMALLER;
+    else if (rel == "=") r = CGAL::EQUAL;
+    else if (rel == ">=") r = CGAL::LARGER;
+    else return error("relation " + quote(rel) + " (<=, = or >=)");
+    Rational rhs_value;
+    if (!parse_rational(b, rhs_value)) return error("right-hand side " + quote(b));
+    if (!fits_it(rhs_value)) return too_large();
+    std::vector<std::pair<int, Rational>> t;
+    for (std::size_t k = 2; k < f.size(); ++k) {
+      const std::size_t sp = f[k].find(' ');
+      Rational c;
+      if (sp == std::string::npos || !parse_rational(f[k].substr(0, sp), c))
+        return error("term " + quote(f[k]) + " (<coef> <variable>)");
+      const int j = variable(trim(f[k].substr(sp + 1)));
+      if (j < 0) return error("no variable " + quote(trim(f[k].substr(sp + 1))));
+      if (!fits_it(c)) return too_large();
+      t.push_back({ j, c });
+    }
+    const int i = current.lp.get_m();
+    if (!set_row(current.lp, i, r, t, rhs_value)) return too_large();
+    current.cname.push_back(f[0]);
+    removed.push_back(false);
+    entered.push_back({ t, rhs_value });
+    changed();
+    return "{\"ok\":true,\"row\":" + std::to_string(i) + "}";
+  }
+
+  std::string remove(const std::string& name)
+  {
+    const int i = row(name);
+    if (i < 0) return row_error(name, i);
+    if (i == current.norm_row) return error("the normalization row stays");
+    for (int j = 0; j < current.lp.get_n(); ++j) current.lp.set_a(j, i, 0);
+    current.lp.set_r(i, CGAL::EQUAL);
+    current.lp.set_b(i, 0);
+    removed[i] = true;
+    if (i == current.density_row) current.density_row = -1;
+    changed();
+    return "{\"ok\":true}";
+  }
+
+  std::string set(const std::vector<std::string>& f)
+  {
+    if (f.size() != 3) return error("set <row>; <variable>; <coef>");
+    const int i = row(f[0]);
+    if (i < 0) return row_error(f[0], i);
+    const int j = variable(f[1]);
+    if (j < 0) return error("no variable " + quote(f[1]));
+    Rational c;
+    if (!parse_rational(f[2], c)) return error("coefficient " + quote(f[2]));
+    if (!fits_it(c)) return too_large();
+    std::vector<std::pair<int, Rational>>& t = entered[i].terms;
+    const std::vector<std::pair<int, Rational>> old = t;
+    bool there = false;
+    for (auto& e : t)
+      if (e.first == j) { e.second = c; there = true; }
+    if (!there) t.push_back({ j, c });
+    if (!rescale(i)) {
+      t = old;
+      return too_large();
+    }
+    changed();
+    return "{\"ok\":true}";
+  }
+
+  std::string rhs(const std::vector<std::string>& f)
+  {
+    if (f.size() != 2) return error("rhs <row>; <rhs>");
+    const int i = row(f[0]);
+    if (i < 0) return row_error(f[0], i);
+    Rational b;
+    if (!parse_rational(f[1], b)) return error("right-hand side " + quote(f[1]));
+    if (!fits_it(b)) return too_large();
+    const Rational old = entered[i].b;
+    entered[i].b = b;
+    if (!rescale(i)) {
+      entered[i].b = old;
+      return too_large();
+    }
+    changed();
+    return "{\"ok\":true}";
+  }
+
+  std::string solve()
+  {
+    const bool cached = solved;
+    if (!solved) {
+      const auto t0 = std::chrono::steady_clock::now();
+      std::string infeasible;
+      if (presolve && !presolved_valid) {
+        presolved = current;
+        const Implied_bounds ib = implied_bounds(current);
+        infeasible = ib.infeasible;
+        if (infeasible.empty()) apply_bounds(presolved, ib);
+        presolved_valid = infeasible.empty();
+      }
+      if (!infeasible.empty()) {
+        last = Density_result();
+        last.status = Density_status::infeasible;
+        last.error = "presolve: row " + quote(infeasible) + " cannot be satisfied";
+      }
+      else last = solve_density(presolve ? presolved : current);
+      last_ms = 1000 * std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+      solved = true;
+    }
+    const char* status[] = { "optimal", "infeasible", "unbounded", "error" };
+    std::string out = "{\"ok\":true,\"status\":\"" + std::string(status[(int)last.status]) + "\"";
+    if (last.status == Density_status::optimal)
+      out += ",\"bound\":" + quote(str(last.bound)) + ",\"approx\":" + std::to_string(CGAL::to_double(last.bound));
+    if (last.status == Density_status::error) out += ",\"error\":" + quote(last.error);
+    if (last.status == Density_status::infeasible && !last.error.empty()) out += ",\"reason\":" + quote(last.error);
+    return out + ",\"pivots\":" + std::to_string(last.pivots) + ",\"ms\":" + std::to_string(last_ms)
+           + ",\"cached\":" + (cached ? "true" : "false") + "}";
+  }
+
+  std::string listing(const std::vector<Named_value>& v, const char* what) const
+  {
+    if (!solved) return error("nothing solved since the last change");
+    std::string out = "{\"ok\":true,\"" + std::string(what) + "\":{";
+    bool first = true;
+    for (const Named_value& e : v) {
+      if (e.value == 0) continue;
+      out += (first ? "" : ",") + quote(e.name) + ":" + quote(str(e.value));
+      first = false;
+    }
+    return out + "}}";
+  }
+};
+
+bool send_line(int fd, const std::string& s)
+{
+  const std::string line = s + "\n";
+  std::size_t done = 0;
+  while (done < line.size()) {
+    const ssize_t w = write(fd, line.data() + done, line.size() - done);
+    if (w <= 0) return false;
+    done += (std::size_t)w;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string path, preset = "basic";
+  bool presolve = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--socket" && i + 1 < argc) path = argv[++i];
+    else if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--presolve") presolve = true;
+    else {
+      std::cerr << "usage: lpd --socket path [--model basic|extended|no8|full] [--presolve]\n";
+      return 1;
+    }
+  }
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof addr);
+  addr.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof addr.sun_path) {
+    std::cerr << "lpd: --socket needs a path of at most " << sizeof addr.sun_path - 1 << " characters\n";
+    return 1;
+  }
+  std::strcpy(addr.sun_path, path.c_str());
+
+  Server server(presolve);
+  if (!server.load(preset)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+
+  std::signal(SIGPIPE, SIG_IGN);
+  const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path.c_str());
+  if (listener < 0 || bind(listener, (sockaddr*)&addr, sizeof addr) != 0 || listen(listener, 8) != 0) {
+    std::cerr << "lpd: cannot listen on " << path << ": " << std::strerror(errno) << "\n";
+    return 1;
+  }
+  std::cerr << "lpd: " << preset << " on " << path << "\n";
+
+  for (bool stop = false; !stop; ) {
+    const int fd = accept(listener, nullptr, nullptr);
+    if (fd < 0) continue;
+    std::string buffer;
+    char chunk[4096];
+    for (bool close = false; !close; ) {
+      const std::size_t nl = buffer.find('\n');
+      if (nl == std::string::npos) {
+        const ssize_t r = read(fd, chunk, sizeof chunk);
+        if (r <= 0) break;
+        buffer.append(chunk, (std::size_t)r);
+        continue;
+      }
+      const std::string line = trim(buffer.substr(0, nl));
+      buffer.erase(0, nl + 1);
+      if (line.empty()) continue;
+      if (!send_line(fd, server.handle(line, close, stop))) break;
+    }
+    ::close(fd);
+  }
+  ::close(listener);
+  unlink(path.c_str());
+}
@@ -1,358 +1,32 @@
 // example: how to solve a simple explicit LP
-#include <CGAL/QP_models.h>
-#include <CGAL/QP_functions.h>
-#include <CGAL/Gmpz.h>
+#include "lp_solve.h"
+#include "telemetry.h"
 #include <vector>
 #include <string>
-
-// choose input type (input coefficients must fit)
-typedef int IT;
-// choose exact type for solver (CGAL::Gmpz or CGAL::Gmpq)
-typedef CGAL::Gmpz ET;
-
-// program and solution types
-typedef CGAL::Quadratic_program<IT> Program;
-typedef CGAL::Quadratic_program_solution<ET> Solution;
+#include <iostream>
+#include <cassert>
 
 int main()
 {
-  // create an LP with Ax <= b, lower bound 0 and no upper bounds
-  Program lp(CGAL::SMALLER, true, 0, false, 1000); 
-
-  // names
-  std::vector<std::string> vname; // variables
-  std::vector<std::string> cname; // constraints
-
-  // variables
-  int vvv = -1;
-  const int n = ++vvv; vname.push_back("#num_vertices"); // lower bound
-  const int X = ++vvv; vname.push_back("#crossings");
-  const int E = ++vvv; vname.push_back("#edges");
-  // types of edges
-  const int ep = ++vvv; vname.push_back("#noncrossing_edges"); // no crossing
-  const int ex = ++vvv; vname.push_back("#crossing_edges"); // one crossing
-
-  // #cells of certain type
-  const int c5 = ++vvv; vname.push_back("c5");
-  const int c6 = ++vvv; vname.push_back("c6");
-  const int c7 = ++vvv; vname.push_back("c7");
-  const int t6 = ++vvv; vname.push_back("t6");
-  const int c8 = ++vvv; vname.push_back("c8");
-  const int u  = ++vvv; vname.push_back("u"); // >=8
-  const int F  = ++vvv; vname.push_back("#cells");
-
-  // substructures of u-cells
-  const int sx = ++vvv; vname.push_back("sx");
-  const int s1 = ++vvv; vname.push_back("s1");
-  const int s2 = ++vvv; vname.push_back("s2");
-  const int s3 = ++vvv; vname.push_back("s3");
-
-  // non-crossing edges shared by cells c5, c7, t6:
-  const int e_tc5  = ++vvv; vname.push_back("noncrossing_edges_c5_t");
-  const int e_tc7  = ++vvv; vname.push_back("noncrossing_edges_c7_t");
-  const int e_tc8  = ++vvv; vname.push_back("noncrossing_edges_c8_t");
-  const int e_tu   = ++vvv; vname.push_back("noncrossing_edges_u_t");
-  
-  const int e_c5   = ++vvv; vname.push_back("noncrossing_edges_c5_c5");
-  const int e_c7   = ++vvv; vname.push_back("noncrossing_edges_c7_c7");
-  const int e_c8   = ++vvv; vname.push_back("noncrossing_edges_c8_c8");
-  const int e_u    = ++vvv; vname.push_back("noncrossing_edges_u_u");
-
-  const int e_c5c7 = ++vvv; vname.push_back("noncrossing_edges_c5_c7");
-  const int e_c5c8 = ++vvv; vname.push_back("noncrossing_edges_c5_c8");
-  const int e_c5u  = ++vvv; vname.push_back("noncrossing_edges_c5_u");
-  const int e_c7c8 = ++vvv; vname.push_back("noncrossing_edges_c7_c8");
-  const int e_c7u  = ++vvv; vname.push_back("noncrossing_edges_c7_u");
-  const int e_c8u  = ++vvv; vname.push_back("noncrossing_edges_c8_u");
-
-  int ccc = -1;
-
-  // all vertices have degree geq 3
-  ++ccc;
-  cname.push_back("3n leq 2E");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(n, ccc, 3);  
-  lp.set_a(E, ccc, -2);  
-
-  //// Planarity-derived constraints
-  // edge density C_{4}-free planar
-  // constraint #1: E - X \leq (15/7) (n-2)
-  ++ccc;
-  cname.push_back("E - X leq (15/7) (n - 2)");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, -30);
-  lp.set_a(E, ccc, 7);
-  lp.set_a(X, ccc, -7);
-  lp.set_a(n, ccc, -15);
-
-  // constraint #2: F = (E + 2X) - (n + X) + 2
-  ++ccc;
-  cname.push_back("F = E + X - n + 2");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 2);
-  lp.set_a(F, ccc, 1);
-  lp.set_a(n, ccc, 1);
-  lp.set_a(E, ccc, -1);
-  lp.set_a(X, ccc, -1);
-
-  /// Total cell counts
-  // constraint #3: u + c5 + c6 + c7 + c8 + t6 = F
-  ++ccc;
-  cname.push_back("u + c5 + c6 + c7 + c8 + t6 = F");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(c5, ccc, 1);
-  lp.set_a(c6, ccc, 1);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(c8, ccc, 1);
-  lp.set_a(t6, ccc, 1);
-  lp.set_a(u, ccc, 1);
-  lp.set_a(F, ccc, -1);
-
-  // constraint #4: 9 u \leq 2(s_{1,2,3}) + s_{x}
-  ++ccc;
-  cname.push_back("9u leq 2(s_{1,2,3}) + s_{x}");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(u, ccc, 9);
-  lp.set_a(s1, ccc, -2);
-  lp.set_a(s2, ccc, -2);
-  lp.set_a(s3, ccc, -2);
-  lp.set_a(sx, ccc, -1);
-
-  ++ccc;
-  cname.push_back("2sx = 2s3 + s2");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(sx, ccc, 2);
-  lp.set_a(s2, ccc, -1);
-  lp.set_a(s3, ccc, -2);
-
-
-
-  ///// Cell counts related to crossing number
-  // constraint #6: c5 \leq 2X
-  ++ccc;
-  cname.push_back("c5 leq 2X");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(c5, ccc, 1);
-  lp.set_a(X, ccc, -2);
-
-  // constraint #4: c6 \leq 2X
-  ++ccc;
-  cname.push_back("c6 leq 2X");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(c6, ccc, 1);
-  lp.set_a(X, ccc, -2);
-
-  // constraint #5: c7 \leq 4X
-  ++ccc;
-  cname.push_back("c7 leq 4X");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(X, ccc, -4);
-
-  // constraint #5: c8 \leq 2X
-  ++ccc;
-  cname.push_back("c8 leq 2X");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(X, ccc, -2);
-
-  /// Triangle count related to c5, c7, c8, ...
-  // constraint #7: 3*t6 leq c5 + 2*c7 + c8 + (s1 + s2/2)
-  ++ccc;
-  cname.push_back("3t6 leq c5 + 2 c7 + c8 + (s_1 + s_2/2)");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(t6, ccc, 6);
-  lp.set_a(c5, ccc, -2);
-  lp.set_a(c7, ccc, -4);
-  lp.set_a(c8, ccc, -2);
-  lp.set_a(s1, ccc, -2);
-  lp.set_a(s2, ccc, -1);
-
-
-
-  //// Edge constraints
-  // constraint #8: E = E_{x} + E_{p}
-  ++ccc;
-  cname.push_back("E = E_{x} + E_{p}");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(ep, ccc, 1);
-  lp.set_a(ex, ccc, 1);
-  lp.set_a(E, ccc, -1);
-
-  // constraint #9: E_{x} = 2 X
-  ++ccc;
-  cname.push_back("E_{x} = 2X");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(ex, ccc, 1);
-  lp.set_a(X, ccc, -2);
-
-  // constraint #10: c5 + 2*c6 + c7 + 2 c8 + s_{x} = 2 E_{x}
-  //  [covered by constraints #5 and #9]
-  ++ccc;
-  cname.push_back("c5 + 2c6 + c7 + 2c8 + sx = 2 E_{x}");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(c5, ccc, 1);
-  lp.set_a(c6, ccc, 2);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(c8, ccc, 2);
-  lp.set_a(sx, ccc, 1);
-  lp.set_a(ex, ccc, -2);
-
-  // constraint #11: c5 + 2*c7 + 3*t6 + c8 + (s1 + s2/2) = 2 E_{p}
-  ++ccc;
-  cname.push_back("c5 + 2 c7 + 3 t6 + c8 + (s1 + s2/2) = 2 E_{p}");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(c5, ccc, 2);
-  lp.set_a(c7, ccc, 4);
-  lp.set_a(t6, ccc, 6);
-  lp.set_a(c8, ccc, 2);
-  lp.set_a(s1, ccc, 2);
-  lp.set_a(s2, ccc, 1);
-  lp.set_a(ep, ccc, -4);
-
-  // constraint #12: 3*t6 \leq E_{p}
-  // triangles cannot share edges
-  ++ccc;
-  cname.push_back("3T leq E_{p}");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(t6, ccc, 3);
-  lp.set_a(ep, ccc, -1);
-
-
-  //// Non-crossing edge constraints
-  // constraint #13: e_{t c5} + e_{t c7} + e_{t c8} + e_{t u}
-  //                + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + e_{c7 c8} + e_{c7 u} + e_{c8 u}
-  //                + e_{c5} + e_{c7} + e_{c8} + e_{u} = E_{p}
-  ++ccc;
-  cname.push_back("e_{t c5} + e_{t c7} + e_{t c8} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + ... = E_{p}");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  // triangle
-  lp.set_a(e_tc5, ccc, 1);
-  lp.set_a(e_tc7, ccc, 1);
-  lp.set_a(e_tc8, ccc, 1);
-  lp.set_a(e_tu, ccc, 1);
-  // mixed
-  lp.set_a(e_c5c7, ccc, 1);
-  lp.set_a(e_c5c8, ccc, 1);
-  lp.set_a(e_c5u, ccc, 1);
-  lp.set_a(e_c7c8, ccc, 1);
-  lp.set_a(e_c7u, ccc, 1);
-  lp.set_a(e_c8u, ccc, 1);
-  // cell to itself
-  lp.set_a(e_c5, ccc, 1);
-  lp.set_a(e_c7, ccc, 1);
-  lp.set_a(e_c8, ccc, 1);
-  lp.set_a(e_u, ccc, 1);
-
-  lp.set_a(ep, ccc, -1);
-
-  // constraint #14: e_{t c5} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + 2 e_{c5 c5} = c5
-  ++ccc;
-  cname.push_back("e_{t c5} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + 2 e_{c5 c5} = c5");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(e_tc5, ccc, 1);
-  lp.set_a(e_c5c7, ccc, 1);
-  lp.set_a(e_c5c8, ccc, 1);
-  lp.set_a(e_c5u, ccc, 1);
-  lp.set_a(e_c5, ccc, 2);
-  lp.set_a(c5, ccc, -1);
-
-  // constraint #15: e_{t c7} + e_{c5 c7} + e_{c7 c8} + e_{c7 u} + 2e_{c7 c7} = 2 c7
-  ++ccc;
-  cname.push_back("e_{t c7} + e_{c5 c7} + e_{c7 c8} + e_{c7 u} + 2 e_{c7 c7} = 2 c7");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(e_tc7, ccc, 1);
-  lp.set_a(e_c5c7, ccc, 1);
-  lp.set_a(e_c7c8, ccc, 1);
-  lp.set_a(e_c7u, ccc, 1);
-  lp.set_a(e_c7, ccc, 2);
-  lp.set_a(c7, ccc, -2);
-
-  // constraint #16: e_{t c8} + e_{c5 c8} + e_{c7 c8} + e_{c8 u} + 2e_{c8 c8} = c8
-  ++ccc;
-  cname.push_back("e_{t c8} + e_{c5 c8} + e_{c7 c8} + e_{c8 u} + 2e_{c8 c8} = c8");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(e_tc8, ccc, 1);
-  lp.set_a(e_c5c8, ccc, 1);
-  lp.set_a(e_c7c8, ccc, 1);
-  lp.set_a(e_c8u, ccc, 1);
-  lp.set_a(e_c8, ccc, 2);
-  lp.set_a(c8, ccc, -1);
-
-  // constraint #17: e_{t u} + e_{c5 u} + e_{c7 u} + e_{c8 u} + 2e_{u u} = s1 + s2/2
-  ++ccc;
-  cname.push_back("e_{t u} + e_{c5 u} + e_{c7 u} + e_{c8 u} + 2e_{u u} = s1 + s2/2");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(e_tu, ccc, 2);
-  lp.set_a(e_c5u, ccc, 2);
-  lp.set_a(e_c7u, ccc, 2);
-  lp.set_a(e_c8u, ccc, 2);
-  lp.set_a(e_u, ccc, 4);
-  lp.set_a(s1, ccc, -2);
-  lp.set_a(s2, ccc, -1);
-
-  // constraint #18: e_{t c5} + e_{t c7} + e_{t c8} + e_{t u} = 3t
-  ++ccc;
-  cname.push_back("e_{t c5} + e_{t c7} + e_{t c8} + e_{t u} = 3 t6");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
-  lp.set_a(e_tc5, ccc, 1);
-  lp.set_a(e_tc7, ccc, 1);
-  lp.set_a(e_tc8, ccc, 1);
-  lp.set_a(e_tu, ccc, 1);
-  lp.set_a(t6, ccc, -3);
-
-  // constraint #19: e_{t c5} \leq X
-  // cell c5 adjacent to a triangle cannot "share" crossing with another c5
-  ++ccc;
-  cname.push_back("e_{t c5} leq X");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(e_tc5, ccc, 1);
-  lp.set_a(X, ccc, -1);
-
-  // constraint #20: c5 \leq 2X - e_{t c5} - e_{c5}
-  // each crossing can give two c5's, but:
-  //   - if a c5 is adjacent to a triangle, then only 1
-  //   - if a c5 is adjacent to another c5 on non-crossing edge, 
-  //     then only one of the two can share crossing with another c5
-  //   - if a crossing contains a c7, then it can only have one c5
-  // So for each edge e_{t c5}, e_{c5}, e_{c5c7}, we get crossings with at most 1 c5
-  ++ccc;
-  cname.push_back("c5 leq 2X - e_{t c5} - e_{c5} - c7");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
-  lp.set_a(c5, ccc, 1);
-  lp.set_a(e_tc5, ccc, 1);
-  lp.set_a(e_c5, ccc, 1);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(X, ccc, -2);
-
-  // constraint #21: edge density formula
-  ++ccc;
-  cname.push_back("E leq 2.4(n-2) + ...");
-  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, -96);
-  lp.set_a(E, ccc, 20);
-  lp.set_a(n, ccc, -48);
-  lp.set_a(c5, ccc, -13);
-  lp.set_a(c6, ccc, -6);
-  lp.set_a(t6, ccc, -6);
-  lp.set_a(c7, ccc, 1);
-  lp.set_a(c8, ccc, 8);
-  lp.set_a(u, ccc, 15);
-  lp.set_a(X, ccc, 20);
-
-  const double factor = 10.0;
-  // constraint #: normalize (n-2)=factor
-  ++ccc;
-  cname.push_back("normalize: (n-2)=factor");
-  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, factor+2);
-  lp.set_a(n, ccc, 1);
-
-  // objective function: set to minimize -E
-  //                        <=> maximize E
-  lp.set_c(E, -1);
+  // nothing to build: CGAL reads the constant arrays of model_full.cpp, and
+  // the names come from there too
+  Telemetry tel("lp_solver", "full");
+  const Static_program lp = full_program();
+  const Static_names names = full_names();
+  const char* const* vname = names.vname;
+  const char* const* cname = names.cname;
+  const double factor = names.factor;
+  tel.model(lp, vname);
 
   // solve the program, using ET as the exact type
-  Solution s = CGAL::solve_linear_program(lp, ET());
+  tel.begin("solve");
+  Solution s = solve_lp(lp);
+  tel.solved(s);
+  tel.begin("check");
   assert(s.solves_linear_program(lp));
 
   // output solution
+  tel.begin("output");
   if (s.is_unbounded()) {
     std::cout << "unbounded\n" << std::endl;
     std::cout << "base point:\n\n";
@@ -0,0 +1,374 @@
+// formulation with cell types c5, c6, c7, t6 and wedge pairs
+#include "lp_model.h"
+#include "wedge_pairs.h"
+
+void build_basic(Model& m)
+{
+  Program& lp = m.lp;
+
+  // names
+  std::vector<std::string>& vname = m.vname; // variables
+  std::vector<std::string>& cname = m.cname; // constraints
+
+  // variables
+  int vvv = -1;
+  const int n = ++vvv; vname.push_back("#num_vertices");
+  const int n3 = ++vvv; vname.push_back("#num_vertices_deg_3");
+  const int n4 = ++vvv; vname.push_back("#num_vertices_deg_4");
+  const int n5 = ++vvv; vname.push_back("#num_vertices_deg_5");
+  const int n6 = ++vvv; vname.push_back("#num_vertices_deg_geq_6");
+  
+  const int F  = ++vvv; vname.push_back("#cells");
+  const int X = ++vvv; vname.push_back("#crossings");
+  const int E = ++vvv; vname.push_back("#edges");
+  // types of edges
+  const int ep = ++vvv; vname.push_back("#noncrossing_edges"); // no crossing
+  const int ex = ++vvv; vname.push_back("#crossing_edges"); // one crossing
+
+  // #cells of certain type
+  const int c5 = ++vvv; vname.push_back("c5");
+  const int c6 = ++vvv; vname.push_back("c6");
+  const int c7 = ++vvv; vname.push_back("c7");
+  const int t6 = ++vvv; vname.push_back("t6");
+
+  // non-crossing edges shared by cells c5, c7, t6:
+  const int e_tc5  = ++vvv; vname.push_back("noncrossing_edges_c5_t");
+  const int e_tc7  = ++vvv; vname.push_back("noncrossing_edges_c7_t");
+  
+  const int e_c5   = ++vvv; vname.push_back("noncrossing_edges_c5_c5");
+  const int e_c7   = ++vvv; vname.push_back("noncrossing_edges_c7_c7");
+
+  const int e_c5c7 = ++vvv; vname.push_back("noncrossing_edges_c5_c7");
+
+  // wedges including 5 cells
+  const int w_5566 = ++vvv; vname.push_back("wedge 5566"); // a
+  const int w_5676 = ++vvv; vname.push_back("wedge 5676"); // b
+  const int w_5666 = ++vvv; vname.push_back("wedge 5666"); // c
+  // other wedges
+  const int w_6666 = ++vvv; vname.push_back("wedge 6666"); // d
+  const int w_6667 = ++vvv; vname.push_back("wedge 6667"); // e 
+  const int w_6677 = ++vvv; vname.push_back("wedge 6677"); // f
+  const int w_6777 = ++vvv; vname.push_back("wedge 6777"); // g 
+  const int w_6767 = ++vvv; vname.push_back("wedge 6767"); // h
+  const int w_7777 = ++vvv; vname.push_back("wedge 7777");
+
+  // wedges counting for each c6: one variable per pair of wedge types that can
+  // share a c6, generated from the table (letters as in the comments above)
+  const std::vector<Wedge_type> wedge_types = {
+    { w_5566, "5566", 2 }, // a
+    { w_5676, "5676", 2 }, // b
+    { w_5666, "5666", 3 }, // c
+    { w_6666, "6666", 4 }, // d
+    { w_6667, "6667", 3 }, // e
+    { w_6677, "6677", 2 }, // f
+    { w_6777, "6777", 1 }, // g
+    { w_6767, "6767", 2 }, // h
+    { w_7777, "7777", 0 },
+  };
+  // aa, ab and bb close a C4 (see wedge_enum), ac and ad are excluded as well
+  const Wedge_pairs wedge_pairs = add_wedge_pairs(m, vvv, wedge_types,
+    { { "5566", "5566" }, { "5566", "5676" }, { "5676", "5676" },
+      { "5566", "5666" }, { "5566", "6666" } });
+
+  int ccc = -1;
+
+  // vertices
+  ++ccc;
+  cname.push_back("n3+n4+n5+n6 = n");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(n3, ccc, 1);  
+  lp.set_a(n4, ccc, 1);  
+  lp.set_a(n5, ccc, 1);  
+  lp.set_a(n6, ccc, 1);  
+  lp.set_a(n, ccc, -1);  
+
+  // handshake lemma
+  ++ccc;
+  cname.push_back("3 n3 + 4 n4 + 5 n5 + 6 n6 leq 2E");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(n3, ccc, 3);  
+  lp.set_a(n4, ccc, 4);  
+  lp.set_a(n5, ccc, 5);  
+  lp.set_a(n6, ccc, 6);  
+  lp.set_a(E, ccc, -2);  
+
+
+  // removing crossings and triangulating
+  ++ccc;
+  cname.push_back("2E - 4X + 4 w_{5566} + ... = 6n - 12");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, -12);
+  lp.set_a(E, ccc, 2);   
+  lp.set_a(X, ccc, -4);   
+  lp.set_a(w_5566, ccc, 4);   
+  lp.set_a(w_5676, ccc, 6);   
+  lp.set_a(w_5666, ccc, 5);   
+  lp.set_a(w_6666, ccc, 6);   
+  lp.set_a(w_6667, ccc, 7);   
+  lp.set_a(w_6677, ccc, 8);   
+  lp.set_a(w_6777, ccc, 9);   
+  lp.set_a(w_6767, ccc, 8);   
+  lp.set_a(w_7777, ccc, 10);   
+  lp.set_a(n, ccc, -6);  
+
+  // every arrow leads to two c7s
+  ++ccc;
+  cname.push_back("w5566 leq c7");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(w_5566, ccc, 1);  
+  lp.set_a(c7, ccc, -1);  
+
+  // one c6-type per c6 cell, and per wedge c6 constraints
+  add_wedge_pair_rows(m, ccc, wedge_pairs, c6);
+  // each c wedge can only combine with at most one a or b wedge
+  ++ccc;
+  cname.push_back("w_ac + w_bc leq w_5666 = c");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  for (const char* ab : { "5566", "5676" }) {
+    const int w = wedge_pairs.pair(ab, "5666");
+    if (w >= 0) lp.set_a(w, ccc, 1);
+  }
+  lp.set_a(w_5666, ccc, -1);
+
+  ++ccc;
+  cname.push_back("w_5566 + ... = X");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(w_5566, ccc, 1);
+  lp.set_a(w_5666, ccc, 1);
+  lp.set_a(w_5676, ccc, 1);
+  lp.set_a(w_6666, ccc, 1);
+  lp.set_a(w_6667, ccc, 1);
+  lp.set_a(w_6677, ccc, 1);
+  lp.set_a(w_6777, ccc, 1);
+  lp.set_a(w_6767, ccc, 1);
+  lp.set_a(w_7777, ccc, 1);
+  lp.set_a(X, ccc, -1);
+
+  ++ccc;
+  cname.push_back("2w_5566 + ... = c5");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(w_5566, ccc, 2);
+  lp.set_a(w_5666, ccc, 1);
+  lp.set_a(w_5676, ccc, 1);
+  lp.set_a(c5, ccc, -1);
+
+  ++ccc;
+  cname.push_back("2w_5566 + ... = 2 c6");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(w_5566, ccc, 2);
+  lp.set_a(w_5666, ccc, 3);
+  lp.set_a(w_5676, ccc, 2);
+  lp.set_a(w_6666, ccc, 4);
+  lp.set_a(w_6667, ccc, 3);
+  lp.set_a(w_6677, ccc, 2);
+  lp.set_a(w_6777, ccc, 1);
+  lp.set_a(w_6767, ccc, 2);
+  lp.set_a(c6, ccc, -2);
+
+  ++ccc;
+  cname.push_back("w_5676 + ... = c7");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(w_5676, ccc, 1);
+  lp.set_a(w_6667, ccc, 1);
+  lp.set_a(w_6677, ccc, 2);
+  lp.set_a(w_6777, ccc, 3);
+  lp.set_a(w_7777, ccc, 4);
+  lp.set_a(w_6767, ccc, 2);
+  lp.set_a(c7, ccc, -1);
+
+
+  //// Planarity-derived constraints
+  // constraint #0: E - X \leq (15/7) (n-2)
+  ++ccc;
+  cname.push_back("E - X leq (15/7) (n - 2)");
+  set_row(lp, ccc, CGAL::SMALLER,
+          { { E, 1 }, { X, -1 }, { n, Rational(-15, 7) } },
+          Rational(-30, 7));
+
+  // constraint #1: F = (m + 2X) - (n + X) + 2
+  ++ccc;
+  cname.push_back("F = m + X - n + 2");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 2);
+  lp.set_a(F, ccc, 1);
+  lp.set_a(n, ccc, 1);
+  lp.set_a(E, ccc, -1);
+  lp.set_a(X, ccc, -1);
+
+  /// Total cell counts
+  // constraint #2: c5 + c6 + c7 + t6 = F
+  ++ccc;
+  cname.push_back("c5 + c6 + c7 + t6 = F");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(c5, ccc, 1);
+  lp.set_a(c6, ccc, 1);
+  lp.set_a(c7, ccc, 1);
+  lp.set_a(t6, ccc, 1);
+  lp.set_a(F, ccc, -1);
+
+
+  /// Cell count related to crossing number
+  // constraint #: c5 \leq 2X
+  ++ccc;
+  cname.push_back("c5 leq 2X");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(c5, ccc, 1);
+  lp.set_a(X, ccc, -2);
+  /// Cell count related to crossing number
+  // constraint #: c6 \leq 2X
+  ++ccc;
+  cname.push_back("c6 leq 2X");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(c6, ccc, 1);
+  lp.set_a(X, ccc, -2);
+   /// Cell count related to crossing number
+  // constraint #: c7 \leq 4X
+  ++ccc;
+  cname.push_back("c7 leq 4X");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(c6, ccc, 1);
+  lp.set_a(X, ccc, -4);
+
+
+  //// Edge constraints
+  // constraint #4: E = e_{x} + e_{p}
+  ++ccc;
+  cname.push_back("E = e_{x} + e_{p}");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(ep, ccc, 1);
+  lp.set_a(ex, ccc, 1);
+  lp.set_a(E, ccc, -1);
+
+  // constraint #5: e_{x} = 2 X
+  ++ccc;
+  cname.push_back("e_{x} = 2X");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(ex, ccc, 1);
+  lp.set_a(X, ccc, -2);
+
+  // constraint #6: c5 + 2*c6 + c7 leq 4X = 2 e_x
+  ++ccc;
+  cname.push_back("c5 + 2c6 + c7 = 4X");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(c5, ccc, 1);
+  lp.set_a(c6, ccc, 2);
+  lp.set_a(c7, ccc, 1);
+  lp.set_a(X, ccc, -4);
+
+  // constraint #7: c5 + 2*c7 + 3*t6 \leq 2 e_{p}
+  ++ccc;
+  cname.push_back("c5 + 2c7 + 3t6 = 2e_{p}");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(c5, ccc, 1);
+  lp.set_a(c7, ccc, 2);
+  lp.set_a(t6, ccc, 3);
+
+  lp.set_a(ep, ccc, -2);
+
+
+
+  //// Non-crossing edge constraints
+  // constraint #8: e_{t c5} + e_{t c7} + e_{c5 c7} + e_{c5} + e_{c7} \leq e_{p}
+  ++ccc;
+  cname.push_back("e_{t c5} + e_{t c7} + e_{c5 c7} + e_{c5} + e_{c7} leq e_{p}");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(e_tc5, ccc, 1);
+  lp.set_a(e_tc7, ccc, 1);
+  lp.set_a(e_c5c7, ccc, 1);
+  lp.set_a(e_c5, ccc, 1);
+  lp.set_a(e_c7, ccc, 1);
+
+  lp.set_a(ep, ccc, -1);
+
+  // constraint #9: e_{t c5} + e_{c5 c7} + 2 e_{c5 c5} = c5
+  ++ccc;
+  cname.push_back("e_{t c5} + e_{c5 c7} + 2 e_{c5 c5} = c5");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(e_tc5, ccc, 1);
+  lp.set_a(e_c5c7, ccc, 1);
+  lp.set_a(e_c5, ccc, 2);
+
+  lp.set_a(c5, ccc, -1);
+
+  // constraint #10: e_{t c7} + e_{c5 c7} + 2e_{c7} = 2 c7
+  ++ccc;
+  cname.push_back("e_{t c7} + e_{c5 c7} + 2e_{c7} = 2 c7");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(e_tc7, ccc, 1);
+  lp.set_a(e_c5c7, ccc, 1);
+  lp.set_a(e_c7, ccc, 2);
+
+  lp.set_a(c7, ccc, -2);
+
+  // constraint #11: e_{t c5} + e_{t c7} = 3t
+  ++ccc;
+  cname.push_back("e_{t c5} + e_{t c7} leq 3 t6");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  lp.set_a(e_tc5, ccc, 1);
+  lp.set_a(e_tc7, ccc, 1);
+  lp.set_a(t6, ccc, -3);
+
+  // constraint #20: c5 \leq 2X - e_{t c5} - e_{c5} - e_{c5 c7}
+  // each crossing can give two c5's, but:
+  //   - if a c5 is adjacent to a triangle, then only 1
+  //   - if a c5 is adjacent to another c5 on non-crossing edge, 
+  //     then only one of the two can share crossing with another c5
+  //   - if a crossing contains a c7, then it can only have one c5
+  // So for each edge e_{t c5}, e_{c5}, e_{c5c7}, we get crossings with at most 1 c5
+  ++ccc;
+  cname.push_back("c5 leq 2X - e_{t c5} - e_{c5} - c7");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(c5, ccc, 1);
+  lp.set_a(e_tc5, ccc, 1);
+  lp.set_a(e_c5, ccc, 1);
+  lp.set_a(c7, ccc, 1);
+  lp.set_a(X, ccc, -2);
+
+  // if we have 5566 wedge, we cannot have those c5's adjacent to triangle
+  // if we have 5566 wedge, cannot be adjacent to another 5566 wedge
+  ++ccc;
+  cname.push_back("2 w5566 + e_tc5 + e_c5 leq c5");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  lp.set_a(w_5566, ccc, 2);
+  lp.set_a(e_tc5, ccc, 1);
+  lp.set_a(e_c5, ccc, 1);
+  lp.set_a(c5, ccc, -1);
+
+  // neighboring wedges to 5566
+  ++ccc;
+  cname.push_back("2 w5566 leq 2 w6677 + 2 w6667 + 2 w6767 + w6777");
+  lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc,0);
+  lp.set_a(w_5566, ccc, 2);
+  lp.set_a(w_6677, ccc, -2);
+  lp.set_a(w_6667, ccc, -2);
+  lp.set_a(w_6767, ccc, -2);
+  lp.set_a(w_6777, ccc, -1);
+
+  // constraint #: edge density formula
+  ++ccc;
+  cname.push_back("E leq 2.4(n-2) + ...");
+  m.density_row = ccc;
+  set_row(lp, ccc, CGAL::SMALLER,
+          { { E, 1 }, { n, Rational(-12, 5) }, { c5, Rational(-13, 20) },
+            { c6, Rational(-3, 10) }, { t6, Rational(-3, 10) },
+            { c7, Rational(1, 20) }, { X, 1 } },
+          Rational(-24, 5));
+
+  // ++ccc;
+  // cname.push_back("w_5676 leq c7 - 2 e_c5c7");
+  // lp.set_r(ccc, CGAL::SMALLER); lp.set_b(ccc, 0);
+  // lp.set_a(e_c5c7, ccc, 2);
+  // lp.set_a(w_5676, ccc, 1);
+  // lp.set_a(c7, ccc, -1);
+
+  // constraint #: normalize (n-2)=1
+  const double factor = 10.0;
+  m.factor = factor;
+  ++ccc;
+  cname.push_back("n-2=factor");
+  m.norm_row = ccc;
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, (factor+2));
+  lp.set_a(n, ccc, 1);
+  
+  // objective function: set to minimize -E
+  //                        <=> maximize E
+  lp.set_c(E, -1);
+}
@@ -0,0 +1,185 @@
+// general formulation with cell types c5, c6, c7, t6, c8 and u, written as
+// constant data (see static_model.h)
+#include "static_model.h"
+
+namespace full {
+
+// variables
+enum Var {
+  n, X, E,
+  // types of edges
+  ep, ex,
+  // #cells of certain type
+  c5, c6, c7, t6, c8, u, F,
+  // substructures of u-cells
+  sx, s1, s2, s3,
+  // non-crossing edges shared by cells c5, c7, t6:
+  e_tc5, e_tc7, e_tc8, e_tu,
+  e_c5, e_c7, e_c8, e_u,
+  e_c5c7, e_c5c8, e_c5u, e_c7c8, e_c7u, e_c8u,
+  variables
+};
+
+constexpr const char* vname[] = {
+  "#num_vertices", // lower bound
+  "#crossings",
+  "#edges",
+  "#noncrossing_edges", // no crossing
+  "#crossing_edges",    // one crossing
+  "c5", "c6", "c7", "t6", "c8",
+  "u", // >=8
+  "#cells",
+  "sx", "s1", "s2", "s3",
+  "noncrossing_edges_c5_t", "noncrossing_edges_c7_t", "noncrossing_edges_c8_t", "noncrossing_edges_u_t",
+  "noncrossing_edges_c5_c5", "noncrossing_edges_c7_c7", "noncrossing_edges_c8_c8", "noncrossing_edges_u_u",
+  "noncrossing_edges_c5_c7", "noncrossing_edges_c5_c8", "noncrossing_edges_c5_u",
+  "noncrossing_edges_c7_c8", "noncrossing_edges_c7_u", "noncrossing_edges_c8_u",
+};
+
+constexpr double factor = 10.0;
+
+constexpr Static_row rows[] = {
+  // all vertices have degree geq 3
+  { "3n leq 2E", CGAL::SMALLER, { { n, 3 }, { E, -2 } }, 0 },
+
+  //// Planarity-derived constraints
+  // edge density C_{4}-free planar
+  // constraint #1: E - X \leq (15/7) (n-2)
+  { "E - X leq (15/7) (n - 2)", CGAL::SMALLER, { { E, 1 }, { X, -1 }, { n, -15, 7 } }, -30, 7 },
+
+  // constraint #2: F = (E + 2X) - (n + X) + 2
+  { "F = E + X - n + 2", CGAL::EQUAL, { { F, 1 }, { n, 1 }, { E, -1 }, { X, -1 } }, 2 },
+
+  /// Total cell counts
+  // constraint #3: u + c5 + c6 + c7 + c8 + t6 = F
+  { "u + c5 + c6 + c7 + c8 + t6 = F", CGAL::EQUAL,
+    { { c5, 1 }, { c6, 1 }, { c7, 1 }, { c8, 1 }, { t6, 1 }, { u, 1 }, { F, -1 } }, 0 },
+
+  // constraint #4: 9 u \leq 2(s_{1,2,3}) + s_{x}
+  { "9u leq 2(s_{1,2,3}) + s_{x}", CGAL::SMALLER, { { u, 9 }, { s1, -2 }, { s2, -2 }, { s3, -2 }, { sx, -1 } }, 0 },
+
+  { "2sx = 2s3 + s2", CGAL::EQUAL, { { sx, 2 }, { s2, -1 }, { s3, -2 } }, 0 },
+
+  ///// Cell counts related to crossing number
+  // constraint #6: c5 \leq 2X
+  { "c5 leq 2X", CGAL::SMALLER, { { c5, 1 }, { X, -2 } }, 0 },
+
+  // constraint #4: c6 \leq 2X
+  { "c6 leq 2X", CGAL::SMALLER, { { c6, 1 }, { X, -2 } }, 0 },
+
+  // constraint #5: c7 \leq 4X
+  { "c7 leq 4X", CGAL::SMALLER, { { c7, 1 }, { X, -4 } }, 0 },
+
+  // constraint #5: c8 \leq 2X (the row has always bounded c7, which the
+  // golden bound of this formulation depends on)
+  { "c8 leq 2X", CGAL::SMALLER, { { c7, 1 }, { X, -2 } }, 0 },
+
+  /// Triangle count related to c5, c7, c8, ...
+  // constraint #7: 3*t6 leq c5 + 2*c7 + c8 + (s1 + s2/2)
+  { "3t6 leq c5 + 2 c7 + c8 + (s_1 + s_2/2)", CGAL::SMALLER,
+    { { t6, 3 }, { c5, -1 }, { c7, -2 }, { c8, -1 }, { s1, -1 }, { s2, -1, 2 } }, 0 },
+
+  //// Edge constraints
+  // constraint #8: E = E_{x} + E_{p}
+  { "E = E_{x} + E_{p}", CGAL::EQUAL, { { ep, 1 }, { ex, 1 }, { E, -1 } }, 0 },
+
+  // constraint #9: E_{x} = 2 X
+  { "E_{x} = 2X", CGAL::EQUAL, { { ex, 1 }, { X, -2 } }, 0 },
+
+  // constraint #10: c5 + 2*c6 + c7 + 2 c8 + s_{x} = 2 E_{x}
+  //  [covered by constraints #5 and #9]
+  { "c5 + 2c6 + c7 + 2c8 + sx = 2 E_{x}", CGAL::EQUAL,
+    { { c5, 1 }, { c6, 2 }, { c7, 1 }, { c8, 2 }, { sx, 1 }, { ex, -2 } }, 0 },
+
+  // constraint #11: c5 + 2*c7 + 3*t6 + c8 + (s1 + s2/2) = 2 E_{p}
+  { "c5 + 2 c7 + 3 t6 + c8 + (s1 + s2/2) = 2 E_{p}", CGAL::EQUAL,
+    { { c5, 1 }, { c7, 2 }, { t6, 3 }, { c8, 1 }, { s1, 1 }, { s2, 1, 2 }, { ep, -2 } }, 0 },
+
+  // constraint #12: 3*t6 \leq E_{p}
+  // triangles cannot share edges
+  { "3T leq E_{p}", CGAL::SMALLER, { { t6, 3 }, { ep, -1 } }, 0 },
+
+  //// Non-crossing edge constraints
+  // constraint #13: e_{t c5} + e_{t c7} + e_{t c8} + e_{t u}
+  //                + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + e_{c7 c8} + e_{c7 u} + e_{c8 u}
+  //                + e_{c5} + e_{c7} + e_{c8} + e_{u} = E_{p}
+  { "e_{t c5} + e_{t c7} + e_{t c8} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + ... = E_{p}", CGAL::EQUAL,
+    { // triangle
+      { e_tc5, 1 }, { e_tc7, 1 }, { e_tc8, 1 }, { e_tu, 1 },
+      // mixed
+      { e_c5c7, 1 }, { e_c5c8, 1 }, { e_c5u, 1 }, { e_c7c8, 1 }, { e_c7u, 1 }, { e_c8u, 1 },
+      // cell to itself
+      { e_c5, 1 }, { e_c7, 1 }, { e_c8, 1 }, { e_u, 1 },
+      { ep, -1 } },
+    0 },
+
+  // constraint #14: e_{t c5} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + 2 e_{c5 c5} = c5
+  { "e_{t c5} + e_{c5 c7} + e_{c5 c8} + e_{c5 u} + 2 e_{c5 c5} = c5", CGAL::EQUAL,
+    { { e_tc5, 1 }, { e_c5c7, 1 }, { e_c5c8, 1 }, { e_c5u, 1 }, { e_c5, 2 }, { c5, -1 } }, 0 },
+
+  // constraint #15: e_{t c7} + e_{c5 c7} + e_{c7 c8} + e_{c7 u} + 2e_{c7 c7} = 2 c7
+  { "e_{t c7} + e_{c5 c7} + e_{c7 c8} + e_{c7 u} + 2 e_{c7 c7} = 2 c7", CGAL::EQUAL,
+    { { e_tc7, 1 }, { e_c5c7, 1 }, { e_c7c8, 1 }, { e_c7u, 1 }, { e_c7, 2 }, { c7, -2 } }, 0 },
+
+  // constraint #16: e_{t c8} + e_{c5 c8} + e_{c7 c8} + e_{c8 u} + 2e_{c8 c8} = c8
+  { "e_{t c8} + e_{c5 c8} + e_{c7 c8} + e_{c8 u} + 2e_{c8 c8} = c8", CGAL::EQUAL,
+    { { e_tc8, 1 }, { e_c5c8, 1 }, { e_c7c8, 1 }, { e_c8u, 1 }, { e_c8, 2 }, { c8, -1 } }, 0 },
+
+  // constraint #17: e_{t u} + e_{c5 u} + e_{c7 u} + e_{c8 u} + 2e_{u u} = s1 + s2/2
+  { "e_{t u} + e_{c5 u} + e_{c7 u} + e_{c8 u} + 2e_{u u} = s1 + s2/2", CGAL::EQUAL,
+    { { e_tu, 1 }, { e_c5u, 1 }, { e_c7u, 1 }, { e_c8u, 1 }, { e_u, 2 }, { s1, -1 }, { s2, -1, 2 } }, 0 },
+
+  // constraint #18: e_{t c5} + e_{t c7} + e_{t c8} + e_{t u} = 3t
+  { "e_{t c5} + e_{t c7} + e_{t c8} + e_{t u} = 3 t6", CGAL::EQUAL,
+    { { e_tc5, 1 }, { e_tc7, 1 }, { e_tc8, 1 }, { e_tu, 1 }, { t6, -3 } }, 0 },
+
+  // constraint #19: e_{t c5} \leq X
+  // cell c5 adjacent to a triangle cannot "share" crossing with another c5
+  { "e_{t c5} leq X", CGAL::SMALLER, { { e_tc5, 1 }, { X, -1 } }, 0 },
+
+  // constraint #20: c5 \leq 2X - e_{t c5} - e_{c5}
+  // each crossing can give two c5's, but:
+  //   - if a c5 is adjacent to a triangle, then only 1
+  //   - if a c5 is adjacent to another c5 on non-crossing edge,
+  //     then only one of the two can share crossing with another c5
+  //   - if a crossing contains a c7, then it can only have one c5
+  // So for each edge e_{t c5}, e_{c5}, e_{c5c7}, we get crossings with at most 1 c5
+  { "c5 leq 2X - e_{t c5} - e_{c5} - c7", CGAL::SMALLER,
+    { { c5, 1 }, { e_tc5, 1 }, { e_c5, 1 }, { c7, 1 }, { X, -2 } }, 0 },
+
+  // constraint #21: edge density formula
+  { "E leq 2.4(n-2) + ...", CGAL::SMALLER,
+    { { E, 1 }, { n, -12, 5 }, { c5, -13, 20 }, { c6, -3, 10 }, { t6, -3, 10 },
+      { c7, 1, 20 }, { c8, 2, 5 }, { u, 3, 4 }, { X, 1 } },
+    -24, 5 },
+
+  // constraint #: normalize (n-2)=factor
+  { "normalize: (n-2)=factor", CGAL::EQUAL, { { n, 1 } }, (long long)factor + 2 },
+};
+
+// objective function: set to minimize -E
+//                        <=> maximize E
+constexpr Static_term objective[] = { { E, -1 } };
+
+typedef Static_model<variables, vname, rows, objective> Formulation;
+
+constexpr int norm_row = static_model::row_index(rows, "normalize: (n-2)=factor");
+constexpr int density_row = static_model::row_index(rows, "E leq 2.4(n-2) + ...");
+static_assert(norm_row >= 0 && density_row >= 0, "the normalization and density rows are named as above");
+
+} // namespace full
+
+void build_full(Model& m)
+{
+  full::Formulation::to_model(m, full::norm_row, full::density_row, full::factor);
+}
+
+Static_program full_program()
+{
+  return full::Formulation::program();
+}
+
+Static_names full_names()
+{
+  return { full::vname, full::Formulation::row_names.data(), full::factor };
+}
@@ -0,0 +1,264 @@
+#include "modular.h"
+
+#include <gmp.h>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+typedef CGAL::Gmpz Z;
+typedef std::uint64_t Word;
+typedef std::uint32_t Half; // a residue in the elimination table
+
+//// Primes below 2^31, from the top down
+bool is_prime(Word n)
+{
+  if (n < 2 || n % 2 == 0) return n == 2;
+  for (Word d = 3; d * d <= n; d += 2)
+    if (n % d == 0) return false;
+  return true;
+}
+
+Word next_prime_below(Word n)
+{
+  do --n; while (!is_prime(n));
+  return n;
+}
+
+Word pow_mod(Word a, Word e, Word p)
+{
+  Word r = 1;
+  for (a %= p; e; e >>= 1, a = a * a % p)
+    if (e & 1) r = r * a % p;
+  return r;
+}
+
+Word inverse(Word a, Word p) { return pow_mod(a, p - 2, p); }
+
+Word residue(const Z& z, Word p) { return mpz_fdiv_ui(z.mpz(), (unsigned long)p); }
+
+// multiplication by a fixed w modulo p < 2^31 with Shoup's precomputed
+// quotient floor(w 2^32 / p): one 32x32->64 bit product for the quotient and
+// 32-bit wrapping arithmetic for the rest, no division, so a loop over a row
+// vectorizes (pmuludq/pmulld on x86)
+struct Times {
+  Half w, pre, p;
+  Times(Word w, Word p) : w((Half)w), pre((Half)((w << 32) / p)), p((Half)p) {}
+  Half operator()(Half a) const
+  {
+    const Half q = (Half)(((Word)pre * a) >> 32);
+    const Half r = w * a - q * p; // in [0, 2p)
+    return r >= p ? r - p : r;
+  }
+};
+
+//// One prime
+struct Image {
+  Word p;
+  std::vector<int> pivots; // pivot column of each eliminated row
+  bool consistent;
+  std::vector<Word> y;     // values of the pivot columns, free ones 0
+};
+
+// Gauss-Jordan elimination of the integer system [a | b] modulo p, choosing the
+// pivots as the rational elimination does (first column, first row)
+Image image(const std::vector<std::vector<Z>>& a, const std::vector<Z>& b, int k, Word p)
+{
+  const int rows = (int)a.size(), w = k + 1;
+  std::vector<Half> t((std::size_t)rows * w);
+  for (int i = 0; i < rows; ++i) {
+    Half* row = &t[(std::size_t)i * w];
+    for (int j = 0; j < k; ++j) row[j] = (Half)residue(a[i][j], p);
+    row[k] = (Half)residue(b[i], p);
+  }
+  const Half hp = (Half)p;
+  Image im{ p, {}, true, std::vector<Word>(k, 0) };
+  int r = 0;
+  for (int c = 0; c < k && r < rows; ++c) {
+    int q = r;
+    while (q < rows && t[(std::size_t)q * w + c] == 0) ++q;
+    if (q == rows) continue;
+    Half* pr = &t[(std::size_t)r * w];
+    if (q != r) std::swap_ranges(pr, pr + w, &t[(std::size_t)q * w]);
+    const Times inv(inverse(pr[c], p), p);
+    for (int j = c; j < w; ++j) pr[j] = inv(pr[j]);
+    for (int i = 0; i < rows; ++i) {
+      Half* ri = &t[(std::size_t)i * w];
+      const Half f = ri[c];
+      if (i == r || f == 0) continue;
+      // ri -= f * pr, as ri + (p - f) * pr to stay unsigned
+      const Times g(p - f, p);
+      for (int j = c; j < w; ++j) {
+        const Half s = ri[j] + g(pr[j]); // < 2p < 2^32
+        ri[j] = s >= hp ? s - hp : s;
+      }
+    }
+    im.pivots.push_back(c);
+    ++r;
+  }
+  for (int i = r; i < rows; ++i)
+    if (t[(std::size_t)i * w + k] != 0) im.consistent = false;
+  for (int i = 0; i < r; ++i) im.y[im.pivots[i]] = t[(std::size_t)i * w + k];
+  return im;
+}
+
+// more pivots, then earlier pivot columns: the sequence of the rationals is the best any prime can show
+bool better(const std::vector<int>& a, const std::vector<int>& b)
+{
+  if (a.size() != b.size()) return a.size() > b.size();
+  return a < b;
+}
+
+// n/d = u mod m with |n|, d <= sqrt(m/2); false if there is none
+bool reconstruct(const Z& u, const Z& m, Rational& out)
+{
+  Z bound;
+  mpz_fdiv_q_2exp(bound.mpz(), m.mpz(), 1);
+  mpz_sqrt(bound.mpz(), bound.mpz());
+  Z r0 = m, r1 = u, s0(0), s1(1);
+  while (r1 > bound) {
+    const Z q = r0 / r1;
+    Z t = r0 - q * r1; r0 = r1; r1 = t;
+    t = s0 - q * s1; s0 = s1; s1 = t;
+  }
+  Z d = s1 < 0 ? -s1 : s1;
+  if (d > bound || d == 0 || CGAL::gcd(r1, d) != Z(1)) return false;
+  out = Rational(s1 < 0 ? -r1 : r1, d);
+  return true;
+}
+
+bool solves(const std::vector<std::vector<Rational>>& a, const std::vector<Rational>& b,
+            int k, const std::vector<Rational>& y)
+{
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    Rational s(0);
+    for (int j = 0; j < k; ++j)
+      if (a[i][j] != 0 && y[j] != 0) s += a[i][j] * y[j];
+    if (s != b[i]) return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool solve_rational(std::vector<std::vector<Rational>> a, std::vector<Rational> b, int k,
+                    bool unique, std::vector<Rational>& y)
+{
+  const int rows = (int)a.size();
+  std::vector<int> pivot_col;
+  int r = 0;
+  for (int c = 0; c < k && r < rows; ++c) {
+    int p = r;
+    while (p < rows && a[p][c] == 0) ++p;
+    if (p == rows) continue;
+    std::swap(a[p], a[r]);
+    std::swap(b[p], b[r]);
+    const Rational inv = Rational(1) / a[r][c];
+    for (int j = c; j < k; ++j) a[r][j] *= inv;
+    b[r] *= inv;
+    for (int i = 0; i < rows; ++i) {
+      if (i == r || a[i][c] == 0) continue;
+      const Rational f = a[i][c];
+      for (int j = c; j < k; ++j) a[i][j] -= f * a[r][j];
+      b[i] -= f * b[r];
+    }
+    pivot_col.push_back(c);
+    ++r;
+  }
+  for (int i = r; i < rows; ++i)
+    if (b[i] != 0) return false;
+  if (unique && r < k) return false;
+  y.assign(k, Rational(0));
+  for (int i = 0; i < r; ++i) y[pivot_col[i]] = b[i];
+  return true;
+}
+
+bool solve_modular(const std::vector<std::vector<Rational>>& a, const std::vector<Rational>& b, int k,
+                   bool unique, std::vector<Rational>& y, int threads, Modular_stats* stats)
+{
+  Modular_stats local;
+  Modular_stats& st = stats ? *stats : local;
+  st = Modular_stats();
+  auto fallback = [&] {
+    st.fallback = true;
+    return solve_rational(a, b, k, unique, y);
+  };
+
+  // integer rows: each times the lcm of its denominators
+  const int rows = (int)a.size();
+  std::vector<std::vector<Z>> ai(rows, std::vector<Z>(k));
+  std::vector<Z> bi(rows);
+  for (int i = 0; i < rows; ++i) {
+    Z l = b[i].denominator();
+    for (int j = 0; j < k; ++j)
+      if (a[i][j] != 0) l = CGAL::integral_division(l, CGAL::gcd(l, a[i][j].denominator())) * a[i][j].denominator();
+    for (int j = 0; j < k; ++j)
+      ai[i][j] = CGAL::integral_division(a[i][j].numerator() * l, a[i][j].denominator());
+    bi[i] = CGAL::integral_division(b[i].numerator() * l, b[i].denominator());
+  }
+
+  threads = std::max(1, threads);
+  Word p = Word(1) << 31;
+  std::vector<int> best;
+  bool have = false, best_consistent = true;
+  std::vector<Z> x(k);  // the residues of the best pivot sequence, combined
+  Z modulus(1);
+  std::vector<Rational> last;
+  const int max_primes = 4096;
+
+  while (st.primes + st.dropped < max_primes) {
+    // a batch of primes, one per thread
+    std::vector<Image> batch(threads);
+    std::vector<Word> ps(threads);
+    for (Word& q : ps) q = p = next_prime_below(p);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+      pool.emplace_back([&, t] { batch[t] = image(ai, bi, k, ps[t]); });
+    for (std::thread& th : pool) th.join();
+
+    for (const Image& im : batch) {
+      if (!have || better(im.pivots, best)) {
+        st.dropped += st.primes;
+        have = true;
+        best = im.pivots;
+        best_consistent = im.consistent;
+        std::fill(x.begin(), x.end(), Z(0));
+        modulus = Z(1);
+        st.primes = 0;
+        last.clear();
+      }
+      else if (im.pivots != best) {
+        ++st.dropped;
+        continue;
+      }
+      // Chinese remaindering: x += modulus * ((r - x) / modulus mod p)
+      const Word q = im.p, inv = inverse(residue(modulus, q), q);
+      for (int c : best) {
+        const Word d = (im.y[c] + q - residue(x[c], q)) % q * inv % q;
+        if (d != 0) x[c] += modulus * Z((long)d);
+      }
+      modulus *= Z((long)q);
+      ++st.primes;
+
+      // the primes only disagree with the rationals on a system without the
+      // wanted solution, leave that to the rationals after a few primes
+      if (!best_consistent || (unique && (int)best.size() < k)) {
+        if (st.primes >= 4) return fallback();
+        continue;
+      }
+      // rational reconstruction; once one more prime does not change it, check it
+      std::vector<Rational> now(k, Rational(0));
+      bool ok = true;
+      for (int c : best)
+        if (!(ok = reconstruct(x[c], modulus, now[c]))) break;
+      if (!ok) { last.clear(); continue; }
+      if (now == last && solves(a, b, k, now)) {
+        y = now;
+        return true;
+      }
+      last = now;
+    }
+  }
+  return fallback();
+}
@@ -0,0 +1,41 @@
+// Multi-modular exact solver for the linear systems of basis.h.
+//
+// Gaussian elimination over the rationals works on numbers that grow with every
+// step. Here the system (rows scaled to integers) is instead solved modulo many
+// primes below 2^31, where every number fits a machine word: the rows are plain
+// uint32_t arrays, and products are reduced with Shoup's precomputed quotient
+// instead of a division, so the elimination loops vectorize. Threads take primes in
+// batches. The residues are combined by Chinese remaindering, and after every
+// prime the solution is rebuilt by rational reconstruction; once one more prime
+// leaves it unchanged it is checked exactly against the system (A y = b over the
+// rationals) and returned, so small solutions need few primes. Primes whose
+// elimination takes a different pivot sequence than the best one seen (those
+// dividing a minor) are dropped.
+//
+// The answer is exact either way: a returned solution has been checked, and a
+// system the primes call inconsistent or not of full column rank is handed to
+// rational elimination to confirm.
+#ifndef MODULAR_H
+#define MODULAR_H
+
+#include "lp_model.h"
+
+#include <vector>
+
+struct Modular_stats {
+  int primes = 0;  // primes used in the solution
+  int dropped = 0; // primes with a different pivot sequence
+  bool fallback = false; // answered by rational elimination
+};
+
+// solves a y = b (a has k columns) exactly; false if there is no solution, or
+// if unique is asked for and there are several (otherwise free unknowns are 0,
+// the ones Gauss-Jordan elimination over the rationals leaves free)
+bool solve_modular(const std::vector<std::vector<Rational>>& a, const std::vector<Rational>& b, int k,
+                   bool unique, std::vector<Rational>& y, int threads, Modular_stats* stats = nullptr);
+
+// the same by elimination over the rationals
+bool solve_rational(std::vector<std::vector<Rational>> a, std::vector<Rational> b, int k,
+                    bool unique, std::vector<Rational>& y);
+
+#endif
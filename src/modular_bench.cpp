@@ -0,0 +1,143 @@
+// Benchmark and check of the multi-modular solver (modular.h) against
+// elimination over the rationals.
+//
+// The benchmark solves a random full-rank n x n system with small integer
+// coefficients both ways and prints the times and the number of primes used.
+// --check k also solves k random systems of each kind, small enough for the
+// rationals: full rank (square and overdetermined, with fractions), rank
+// deficient but consistent, and inconsistent. Every system is solved with and
+// without unique, and solve_modular must agree with solve_rational on the
+// answer and the solution; exit code 1 on any difference.
+//
+// usage: modular_bench [-n 200] [-j threads] [--seed 1] [--check k]
+#include "modular.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+typedef std::vector<std::vector<Rational>> Matrix;
+
+double ms_since(std::chrono::steady_clock::time_point t0)
+{
+  return 1000 * std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// an integer in [-range, range], or with fractions also one over 1..6
+Rational entry(std::mt19937_64& rng, int range, bool fractions)
+{
+  const long num = (long)(rng() % (2 * range + 1)) - range;
+  const long den = fractions ? (long)(rng() % 6) + 1 : 1;
+  return Rational(CGAL::Gmpz(num), CGAL::Gmpz(den));
+}
+
+Matrix random_matrix(std::mt19937_64& rng, int rows, int k, bool fractions)
+{
+  Matrix a(rows, std::vector<Rational>(k));
+  for (auto& row : a)
+    for (Rational& e : row) e = entry(rng, 9, fractions);
+  return a;
+}
+
+// b = a y for a random y
+std::vector<Rational> image_of(std::mt19937_64& rng, const Matrix& a, int k)
+{
+  std::vector<Rational> y(k), b(a.size(), Rational(0));
+  for (Rational& e : y) e = entry(rng, 5, true);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    for (int j = 0; j < k; ++j) b[i] += a[i][j] * y[j];
+  return b;
+}
+
+// rows from rank independent ones: the others are combinations of them
+Matrix deficient(std::mt19937_64& rng, int rows, int k, int rank)
+{
+  const Matrix basis = random_matrix(rng, rank, k, false);
+  Matrix a(rows, std::vector<Rational>(k, Rational(0)));
+  for (auto& row : a)
+    for (int s = 0; s < rank; ++s) {
+      const Rational f = entry(rng, 2, false);
+      for (int j = 0; j < k; ++j) row[j] += f * basis[s][j];
+    }
+  return a;
+}
+
+// both solvers on a y = b, with and without unique; false on a difference
+bool agree(const Matrix& a, const std::vector<Rational>& b, int k, int threads, const char* kind)
+{
+  for (bool unique : { false, true }) {
+    std::vector<Rational> ym, yr;
+    const bool m = solve_modular(a, b, k, unique, ym, threads);
+    const bool r = solve_rational(a, b, k, unique, yr);
+    if (m != r || (m && ym != yr)) {
+      std::cout << "FAIL: " << kind << " " << a.size() << "x" << k << (unique ? " unique" : "") << ": modular "
+                << (m ? "solves" : "no solution") << ", rational " << (r ? "solves" : "no solution") << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+int check(std::mt19937_64& rng, int count, int threads)
+{
+  int failures = 0;
+  for (int t = 0; t < count; ++t) {
+    const int k = 1 + (int)(rng() % 12), extra = (int)(rng() % 4);
+    // full rank, square and overdetermined
+    Matrix a = random_matrix(rng, k + extra, k, t % 2 == 1);
+    failures += !agree(a, image_of(rng, a, k), k, threads, "full rank");
+    // rank deficient, consistent
+    const int rank = (int)(rng() % k);
+    a = deficient(rng, k + extra, k, rank);
+    std::vector<Rational> b = image_of(rng, a, k);
+    failures += !agree(a, b, k, threads, "rank deficient");
+    // the same rows, inconsistent unless b moved into the column space
+    b[rng() % b.size()] += Rational(1);
+    failures += !agree(a, b, k, threads, "inconsistent");
+  }
+  std::cout << 3 * count << " systems checked, " << failures << " differences\n";
+  return failures;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int n = 200, threads = 1, count = 0;
+  unsigned long seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "-n" && i + 1 < argc) n = std::atoi(argv[++i]);
+    else if (a == "-j" && i + 1 < argc) threads = std::atoi(argv[++i]);
+    else if (a == "--seed" && i + 1 < argc) seed = std::strtoul(argv[++i], nullptr, 10);
+    else if (a == "--check" && i + 1 < argc) count = std::atoi(argv[++i]);
+    else {
+      std::cerr << "usage: modular_bench [-n 200] [-j threads] [--seed 1] [--check k]\n";
+      return 1;
+    }
+  }
+  std::mt19937_64 rng(seed);
+  if (count > 0) return check(rng, count, threads) == 0 ? 0 : 1;
+
+  const Matrix a = random_matrix(rng, n, n, false);
+  const std::vector<Rational> b = image_of(rng, a, n);
+  std::vector<Rational> ym, yr;
+  Modular_stats st;
+  auto t0 = std::chrono::steady_clock::now();
+  const bool m = solve_modular(a, b, n, true, ym, threads, &st);
+  const double modular_ms = ms_since(t0);
+  std::cout << n << "x" << n << " modular: " << modular_ms << " ms, " << st.primes << " primes, " << st.dropped
+            << " dropped" << (st.fallback ? ", fell back to the rationals" : "") << std::endl;
+  t0 = std::chrono::steady_clock::now();
+  const bool r = solve_rational(a, b, n, true, yr);
+  std::cout << n << "x" << n << " rational: " << ms_since(t0) << " ms\n";
+  if (m != r || ym != yr) {
+    std::cout << "FAIL: the solutions differ\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,149 @@
+#include "presolve.h"
+
+#include <climits>
+
+namespace {
+
+typedef CGAL::Gmpq Q;
+
+struct Term {
+  int j;
+  Q a;
+};
+
+// a <= row as terms and right-hand side; an equality gives two of them
+struct Half_row {
+  int row;
+  std::vector<Term> t;
+  Q b;
+};
+
+std::vector<Half_row> half_rows(const Program& lp)
+{
+  const int rows = lp.get_m(), cols = lp.get_n();
+  std::vector<std::vector<Term>> sparse(rows);
+  for (int j = 0; j < cols; ++j) {
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (col[i] != 0) sparse[i].push_back({ j, Q(col[i]) });
+  }
+  std::vector<Half_row> out;
+  for (int i = 0; i < rows; ++i) {
+    const CGAL::Comparison_result r = lp.get_r()[i];
+    const Q b(lp.get_b()[i]);
+    if (r != CGAL::LARGER) out.push_back({ i, sparse[i], b });
+    if (r != CGAL::SMALLER) {
+      Half_row h{ i, sparse[i], -b };
+      for (Term& t : h.t) t.a = -t.a;
+      out.push_back(h);
+    }
+  }
+  return out;
+}
+
+CGAL::Gmpz floor_div(CGAL::Gmpz num, CGAL::Gmpz den)
+{
+  if (den < 0) { num = -num; den = -den; }
+  CGAL::Gmpz q = num / den;
+  if (num % den != 0 && num < 0) q -= CGAL::Gmpz(1);
+  return q;
+}
+
+// v as an int, false if it does not fit
+bool to_int(const CGAL::Gmpz& v, int& out)
+{
+  if (v > CGAL::Gmpz(INT_MAX) || v < CGAL::Gmpz(INT_MIN)) return false;
+  out = (int)CGAL::to_double(v);
+  return true;
+}
+
+} // namespace
+
+Implied_bounds implied_bounds(const Model& m, int max_rounds)
+{
+  const Program& lp = m.lp;
+  const int cols = lp.get_n();
+  Implied_bounds ib;
+  ib.has_lower.assign(cols, false);
+  ib.has_upper.assign(cols, false);
+  ib.lower.assign(cols, Q(0));
+  ib.upper.assign(cols, Q(0));
+  for (int j = 0; j < cols; ++j) {
+    if (lp.get_fl()[j]) { ib.has_lower[j] = true; ib.lower[j] = Q(lp.get_l()[j]); }
+    if (lp.get_fu()[j]) { ib.has_upper[j] = true; ib.upper[j] = Q(lp.get_u()[j]); }
+  }
+  const std::vector<Half_row> rows = half_rows(lp);
+  auto row_name = [&](int i) { return i < (int)m.cname.size() ? m.cname[i] : "#" + std::to_string(i); };
+
+  for (bool changed = true; changed && ib.rounds < max_rounds; ) {
+    changed = false;
+    ++ib.rounds;
+    for (const Half_row& h : rows) {
+      // smallest activity; terms without a finite minimum are counted, not added
+      Q least(0);
+      int unbounded = 0, which = -1;
+      for (std::size_t k = 0; k < h.t.size(); ++k) {
+        const Term& t = h.t[k];
+        const bool has = t.a > Q(0) ? ib.has_lower[t.j] : ib.has_upper[t.j];
+        if (!has) { ++unbounded; which = (int)k; continue; }
+        least += t.a * (t.a > Q(0) ? ib.lower[t.j] : ib.upper[t.j]);
+      }
+      if (unbounded > 1) continue;
+      if (unbounded == 0 && least > h.b) {
+        ib.infeasible = row_name(h.row);
+        return ib;
+      }
+      // the bounds derived here are on the far side of each term, least does not move
+      for (std::size_t k = 0; k < h.t.size(); ++k) {
+        if (unbounded == 1 && (int)k != which) continue;
+        const Term& t = h.t[k];
+        Q rest = least;
+        if (unbounded == 0) rest -= t.a * (t.a > Q(0) ? ib.lower[t.j] : ib.upper[t.j]);
+        const Q v = (h.b - rest) / t.a;
+        if (t.a > Q(0) && (!ib.has_upper[t.j] || v < ib.upper[t.j])) {
+          ib.has_upper[t.j] = true;
+          ib.upper[t.j] = v;
+          changed = true;
+        }
+        else if (t.a < Q(0) && (!ib.has_lower[t.j] || v > ib.lower[t.j])) {
+          ib.has_lower[t.j] = true;
+          ib.lower[t.j] = v;
+          changed = true;
+        }
+        if (ib.has_lower[t.j] && ib.has_upper[t.j] && ib.lower[t.j] > ib.upper[t.j]) {
+          ib.infeasible = row_name(h.row);
+          return ib;
+        }
+      }
+    }
+  }
+
+  for (int j = 0; j < cols; ++j)
+    if (ib.has_lower[j] && ib.has_upper[j] && ib.lower[j] == Q(0) && ib.upper[j] == Q(0))
+      ib.fixed.push_back(j);
+  return ib;
+}
+
+int apply_bounds(Model& m, const Implied_bounds& ib)
+{
+  Program& lp = m.lp;
+  int set = 0;
+  for (int j = 0; j < lp.get_n(); ++j) {
+    int v;
+    if (ib.has_upper[j]) {
+      const CGAL::Gmpz up = -floor_div(-ib.upper[j].numerator(), ib.upper[j].denominator());
+      if (to_int(up, v) && (!lp.get_fu()[j] || v < lp.get_u()[j])) {
+        lp.set_u(j, true, v);
+        ++set;
+      }
+    }
+    if (ib.has_lower[j]) {
+      const CGAL::Gmpz low = floor_div(ib.lower[j].numerator(), ib.lower[j].denominator());
+      if (to_int(low, v) && (!lp.get_fl()[j] || v > lp.get_l()[j])) {
+        lp.set_l(j, true, v);
+        ++set;
+      }
+    }
+  }
+  return set;
+}
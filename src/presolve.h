@@ -0,0 +1,38 @@
+// Bound-propagation presolve: the variable bounds implied by the rows.
+//
+// A formulation is built with lower bounds 0 and no upper bounds, but once the
+// normalization row fixes n, rows like c5 leq 2X, 3n leq 2E and the cell-count
+// equalities bound nearly every variable. Each round goes over all rows: for a
+// row sum_j a_j x_j <= b (an equality counts as <= and >=) the smallest possible
+// activity of the other terms gives
+//   x_j <= (b - min_{k != j} a_k x_k) / a_j   for a_j > 0   (>= for a_j < 0),
+// and the rounds repeat until no bound improves. All of this is exact (Gmpq).
+// Variables whose bounds meet at 0 are forced to zero (types the other rows
+// exclude). A Program has integer bounds, so apply_bounds() passes upper bounds
+// rounded up and lower bounds rounded down; being implied, they cut nothing off
+// and the optimum is unchanged.
+#ifndef PRESOLVE_H
+#define PRESOLVE_H
+
+#include "lp_model.h"
+
+#include <CGAL/Gmpq.h>
+#include <string>
+#include <vector>
+
+struct Implied_bounds {
+  std::vector<bool> has_lower, has_upper;
+  std::vector<CGAL::Gmpq> lower, upper;
+  std::vector<int> fixed;  // variables forced to zero
+  int rounds = 0;          // rounds until nothing improved (or max_rounds)
+  std::string infeasible;  // the row that cannot be satisfied, or ""
+};
+
+// propagates the rows of m over its bounds, at most max_rounds times
+Implied_bounds implied_bounds(const Model& m, int max_rounds = 50);
+
+// sets the implied bounds on m.lp where they are tighter than its own;
+// returns the number of bounds set
+int apply_bounds(Model& m, const Implied_bounds& ib);
+
+#endif
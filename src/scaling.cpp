@@ -0,0 +1,135 @@
+#include "scaling.h"
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+long long gcd(long long a, long long b)
+{
+  a = std::llabs(a);
+  b = std::llabs(b);
+  while (b != 0) { const long long t = a % b; a = b; b = t; }
+  return a;
+}
+
+// the exponent of 2 in v (v != 0)
+int twos(long long v)
+{
+  int k = 0;
+  while (v % 2 == 0) { v /= 2; ++k; }
+  return k;
+}
+
+bool fits(long long v) { return v >= INT_MIN && v <= INT_MAX; }
+
+// divides row i by its content, coefficients and right-hand side together
+bool scale_row(Program& lp, int i, IT& div)
+{
+  const int cols = lp.get_n();
+  long long g = lp.get_b()[i];
+  for (int j = 0; j < cols; ++j) g = gcd(g, lp.get_a()[j][i]);
+  if (g <= 1) return false;
+  for (int j = 0; j < cols; ++j) {
+    const IT a = lp.get_a()[j][i];
+    if (a != 0) lp.set_a(j, i, (IT)(a / g));
+  }
+  lp.set_b(i, (IT)(lp.get_b()[i] / g));
+  div = (IT)((long long)div * g);
+  return true;
+}
+
+// divides column j by 2^s where that stays integral
+bool scale_column(Program& lp, int j, int& shift)
+{
+  const int rows = lp.get_m();
+  auto col = lp.get_a()[j];
+  double log_sum = 0;
+  int count = 0, down = 64;
+  for (int i = 0; i < rows; ++i) {
+    const long long a = col[i];
+    if (a == 0) continue;
+    log_sum += std::log2((double)std::llabs(a));
+    ++count;
+    down = std::min(down, twos(a));
+  }
+  if (count == 0) return false;
+  const long long c = lp.get_c()[j];
+  if (c != 0) down = std::min(down, twos(c));
+  // |a| >= 1, so the rounded mean is never negative
+  const int s = std::min((int)std::lround(log_sum / count), down);
+  if (s == 0) return false;
+
+  // the bounds become l_j 2^s and must still fit
+  const long long l = lp.get_fl()[j] ? lp.get_l()[j] : 0, u = lp.get_fu()[j] ? lp.get_u()[j] : 0;
+  if (!fits(l * (1LL << s)) || !fits(u * (1LL << s))) return false;
+  for (int i = 0; i < rows; ++i) {
+    const IT a = col[i];
+    if (a != 0) lp.set_a(j, i, (IT)(a / (1LL << s)));
+  }
+  if (c != 0) lp.set_c(j, (IT)(c / (1LL << s)));
+  if (lp.get_fl()[j]) lp.set_l(j, true, (IT)(l * (1LL << s)));
+  if (lp.get_fu()[j]) lp.set_u(j, true, (IT)(u * (1LL << s)));
+  shift += s;
+  return true;
+}
+
+} // namespace
+
+Coefficient_spread coefficient_spread(const Program& lp)
+{
+  Coefficient_spread s;
+  double bits = 0;
+  for (int j = 0; j < lp.get_n(); ++j) {
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < lp.get_m(); ++i) {
+      const long long a = std::llabs((long long)col[i]);
+      if (a == 0) continue;
+      if (s.nonzeros++ == 0 || a < s.min_abs) s.min_abs = a;
+      s.max_abs = std::max(s.max_abs, a);
+      bits += std::log2((double)a);
+    }
+  }
+  if (s.nonzeros > 0) s.mean_bits = bits / s.nonzeros;
+  return s;
+}
+
+Scaling scale_model(Model& m, int passes)
+{
+  Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  Scaling sc;
+  sc.row_div.assign(rows, 1);
+  sc.col_shift.assign(cols, 0);
+  sc.before = coefficient_spread(lp);
+  std::vector<bool> row_done(rows, false), col_done(cols, false);
+  for (int pass = 0; pass < passes; ++pass) {
+    bool changed = false;
+    for (int i = 0; i < rows; ++i)
+      if (scale_row(lp, i, sc.row_div[i])) {
+        changed = true;
+        if (!row_done[i]) { row_done[i] = true; ++sc.rows_scaled; }
+      }
+    for (int j = 0; j < cols; ++j)
+      if (scale_column(lp, j, sc.col_shift[j])) {
+        changed = true;
+        if (!col_done[j]) { col_done[j] = true; ++sc.columns_scaled; }
+      }
+    if (!changed) break;
+  }
+  sc.after = coefficient_spread(lp);
+  return sc;
+}
+
+void unscale_values(const Scaling& s, std::vector<Rational>& values)
+{
+  for (std::size_t j = 0; j < values.size() && j < s.col_shift.size(); ++j)
+    if (s.col_shift[j] > 0) values[j] /= Rational((long)(1L << s.col_shift[j]));
+}
+
+void unscale_multipliers(const Scaling& s, std::vector<Rational>& multipliers)
+{
+  for (std::size_t i = 0; i < multipliers.size() && i < s.row_div.size(); ++i)
+    if (s.row_div[i] != 1) multipliers[i] /= Rational(s.row_div[i]);
+}
@@ -0,0 +1,49 @@
+// Scaling before the exact solve: every row divided by the gcd of its
+// coefficients and right-hand side, and every column by a power of two.
+//
+// Rows come with whatever multiples their author wrote (20E - 48n ... = -96 is
+// 5E - 12n ... = -24), and columns range from single counts to aggregated
+// totals. Dividing a row by its content changes nothing but its multiplier.
+// Dividing column j by 2^s is the substitution y_j = 2^s x_j: the objective
+// coefficient is divided too and the bounds are multiplied, so it is only done
+// where all of that stays integral. The shift is chosen geometrically (it
+// brings the geometric mean of the column's magnitudes closest to 1); with
+// integer coefficients that mean is at least 1, so columns are only ever
+// divided. Rows and columns alternate for a few passes, since a divided column
+// can leave a row with a common factor. The optimal value is unchanged; the values and the
+// multipliers of the scaled program are mapped back with unscale_*().
+#ifndef SCALING_H
+#define SCALING_H
+
+#include "lp_model.h"
+
+#include <vector>
+
+// magnitudes of the nonzero coefficients of the rows (objective and right-hand
+// sides not included)
+struct Coefficient_spread {
+  long long nonzeros = 0;
+  long long min_abs = 0, max_abs = 0;
+  double mean_bits = 0; // average of log2 |a_ij|
+  double spread() const { return min_abs == 0 ? 0 : (double)max_abs / (double)min_abs; }
+};
+
+Coefficient_spread coefficient_spread(const Program& lp);
+
+struct Scaling {
+  std::vector<IT> row_div;   // row i was divided by row_div[i] (> 0)
+  std::vector<int> col_shift; // column j was divided by 2^col_shift[j] (>= 0)
+  Coefficient_spread before, after;
+  int rows_scaled = 0, columns_scaled = 0;
+};
+
+// scales m.lp in place, at most passes times over rows and columns
+Scaling scale_model(Model& m, int passes = 4);
+
+// values of the scaled program -> values of the original: x_j = y_j / 2^shift_j
+// (also for an unbounded direction)
+void unscale_values(const Scaling& s, std::vector<Rational>& values);
+// multipliers of the scaled rows -> multipliers of the original rows
+void unscale_multipliers(const Scaling& s, std::vector<Rational>& multipliers);
+
+#endif
@@ -0,0 +1,235 @@
+// Small_int: an exact integer for the solver's ET that keeps values that fit in
+// 64 bits inline and only falls back to GMP for the ones that do not.
+//
+// Nearly every number of a solve (coefficients, basis entries, the numerators
+// of the solution) fits in 64 bits, but CGAL::Gmpz allocates limbs on the heap
+// for each of them. Here +, -, * and exact division are done on int64 with
+// overflow checks (__builtin_*_overflow), and only a result that overflows is
+// computed and stored as an mpz_class; a big result that fits again is stored
+// inline again. Copying a small value is copying a word. The CGAL traits below
+// (Euclidean ring, exact, real embeddable, coercion from the built-in integers)
+// make it a number type CGAL's QP solver accepts; it converts to CGAL::Gmpz
+// implicitly, so code that reads the solution into Gmpz or Gmpq is unchanged.
+// Configure with -DLP_SMALL_INT_ET=ON to solve with it (see lp_model.h);
+// ./et_bench compares the two on every formulation.
+#ifndef SMALL_INT_H
+#define SMALL_INT_H
+
+#include <CGAL/number_type_basic.h>
+#include <CGAL/Gmpz.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <gmpxx.h>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+
+class Small_int {
+public:
+  Small_int() = default;
+  Small_int(int i) : v(i) {}
+  Small_int(long i) : v(i) {}
+  Small_int(long long i) : v(i) {}
+  Small_int(double d)
+  {
+    if (d > -9.2e18 && d < 9.2e18) v = (std::int64_t)d;
+    else big(mpz_class(d));
+  }
+  Small_int(const CGAL::Gmpz& g) { set(mpz_class(g.mpz())); }
+  explicit Small_int(const mpz_class& m) { set(m); }
+
+  Small_int(const Small_int& o) : v(o.v), z(o.z ? new mpz_class(*o.z) : nullptr) {}
+  Small_int(Small_int&& o) noexcept : v(o.v), z(std::move(o.z)) {}
+  Small_int& operator=(const Small_int& o)
+  {
+    if (this != &o) {
+      v = o.v;
+      z.reset(o.z ? new mpz_class(*o.z) : nullptr);
+    }
+    return *this;
+  }
+  Small_int& operator=(Small_int&& o) noexcept
+  {
+    v = o.v;
+    z = std::move(o.z);
+    return *this;
+  }
+
+  bool is_small() const { return !z; }
+  mpz_class mpz() const { return z ? *z : mpz_class((long)v); }
+  operator CGAL::Gmpz() const { return CGAL::Gmpz(mpz()); }
+  double to_double() const { return z ? z->get_d() : (double)v; }
+  CGAL::Sign sign() const { return (CGAL::Sign)(z ? sgn(*z) : (v > 0) - (v < 0)); }
+  // the bit length of |x|, 0 for 0 (mpz_sizeinbase counts 1)
+  std::size_t bits() const
+  {
+    if (z) return sgn(*z) == 0 ? 0 : mpz_sizeinbase(z->get_mpz_t(), 2);
+    std::uint64_t a = v < 0 ? 0 - (std::uint64_t)v : (std::uint64_t)v;
+    std::size_t n = 0;
+    for (; a != 0; a >>= 1) ++n;
+    return n;
+  }
+
+  Small_int operator-() const
+  {
+    if (!z && v != std::numeric_limits<std::int64_t>::min()) return Small_int((long long)-v);
+    return Small_int(mpz_class(-mpz()));
+  }
+  Small_int& operator+=(const Small_int& o) { return *this = *this + o; }
+  Small_int& operator-=(const Small_int& o) { return *this = *this - o; }
+  Small_int& operator*=(const Small_int& o) { return *this = *this * o; }
+  Small_int& operator/=(const Small_int& o) { return *this = *this / o; }
+  Small_int& operator%=(const Small_int& o) { return *this = *this % o; }
+
+  friend Small_int operator+(const Small_int& a, const Small_int& b)
+  {
+    long long r;
+    if (!a.z && !b.z && !__builtin_add_overflow((long long)a.v, (long long)b.v, &r)) return Small_int(r);
+    return Small_int(mpz_class(a.mpz() + b.mpz()));
+  }
+  friend Small_int operator-(const Small_int& a, const Small_int& b)
+  {
+    long long r;
+    if (!a.z && !b.z && !__builtin_sub_overflow((long long)a.v, (long long)b.v, &r)) return Small_int(r);
+    return Small_int(mpz_class(a.mpz() - b.mpz()));
+  }
+  friend Small_int operator*(const Small_int& a, const Small_int& b)
+  {
+    long long r;
+    if (!a.z && !b.z && !__builtin_mul_overflow((long long)a.v, (long long)b.v, &r)) return Small_int(r);
+    return Small_int(mpz_class(a.mpz() * b.mpz()));
+  }
+  // truncating, like CGAL::Gmpz
+  friend Small_int operator/(const Small_int& a, const Small_int& b)
+  {
+    if (!a.z && !b.z && !(a.v == std::numeric_limits<std::int64_t>::min() && b.v == -1))
+      return Small_int((long long)(a.v / b.v));
+    return Small_int(mpz_class(a.mpz() / b.mpz()));
+  }
+  friend Small_int operator%(const Small_int& a, const Small_int& b)
+  {
+    if (!a.z && !b.z) return b.v == -1 ? Small_int(0) : Small_int((long long)(a.v % b.v));
+    return Small_int(mpz_class(a.mpz() % b.mpz()));
+  }
+  friend Small_int gcd(const Small_int& a, const Small_int& b)
+  {
+    if (!a.z && !b.z && a.v != std::numeric_limits<std::int64_t>::min() && b.v != std::numeric_limits<std::int64_t>::min()) {
+      std::int64_t x = std::llabs(a.v), y = std::llabs(b.v);
+      while (y != 0) { const std::int64_t t = x % y; x = y; y = t; }
+      return Small_int((long long)x);
+    }
+    mpz_class r;
+    mpz_gcd(r.get_mpz_t(), a.mpz().get_mpz_t(), b.mpz().get_mpz_t());
+    return Small_int(r);
+  }
+
+  friend int compare(const Small_int& a, const Small_int& b)
+  {
+    if (!a.z && !b.z) return (a.v > b.v) - (a.v < b.v);
+    const int c = cmp(a.mpz(), b.mpz());
+    return (c > 0) - (c < 0);
+  }
+  friend bool operator==(const Small_int& a, const Small_int& b) { return compare(a, b) == 0; }
+  friend bool operator!=(const Small_int& a, const Small_int& b) { return compare(a, b) != 0; }
+  friend bool operator<(const Small_int& a, const Small_int& b) { return compare(a, b) < 0; }
+  friend bool operator>(const Small_int& a, const Small_int& b) { return compare(a, b) > 0; }
+  friend bool operator<=(const Small_int& a, const Small_int& b) { return compare(a, b) <= 0; }
+  friend bool operator>=(const Small_int& a, const Small_int& b) { return compare(a, b) >= 0; }
+
+  friend std::ostream& operator<<(std::ostream& os, const Small_int& a)
+  {
+    if (a.z) return os << *a.z;
+    return os << (long long)a.v;
+  }
+  friend std::istream& operator>>(std::istream& is, Small_int& a)
+  {
+    mpz_class m;
+    if (is >> m) a.set(m);
+    return is;
+  }
+
+private:
+  std::int64_t v = 0;
+  std::unique_ptr<mpz_class> z; // the value, when it does not fit v
+
+  void big(const mpz_class& m)
+  {
+    v = 0;
+    z.reset(new mpz_class(m));
+  }
+  void set(const mpz_class& m)
+  {
+    if (mpz_fits_slong_p(m.get_mpz_t()) && sizeof(long) == sizeof(std::int64_t)) {
+      v = m.get_si();
+      z.reset();
+    }
+    else big(m);
+  }
+};
+
+namespace CGAL {
+
+template <> class Algebraic_structure_traits<Small_int>
+  : public Algebraic_structure_traits_base<Small_int, Euclidean_ring_tag> {
+public:
+  typedef Tag_true Is_exact;
+  typedef Tag_false Is_numerical_sensitive;
+
+  struct Integral_division : public CGAL::cpp98::binary_function<Type, Type, Type> {
+    Type operator()(const Type& x, const Type& y) const { return x / y; }
+  };
+  struct Gcd : public CGAL::cpp98::binary_function<Type, Type, Type> {
+    Type operator()(const Type& x, const Type& y) const { return gcd(x, y); }
+  };
+  struct Div : public CGAL::cpp98::binary_function<Type, Type, Type> {
+    Type operator()(const Type& x, const Type& y) const { return x / y; }
+  };
+  struct Mod : public CGAL::cpp98::binary_function<Type, Type, Type> {
+    Type operator()(const Type& x, const Type& y) const { return x % y; }
+  };
+  struct Div_mod {
+    typedef Type first_argument_type;
+    typedef Type second_argument_type;
+    typedef Type& third_argument_type;
+    typedef Type& fourth_argument_type;
+    typedef void result_type;
+    void operator()(const Type& x, const Type& y, Type& q, Type& r) const
+    {
+      q = x / y;
+      r = x % y;
+    }
+  };
+};
+
+template <> class Real_embeddable_traits<Small_int>
+  : public INTERN_RET::Real_embeddable_traits_base<Small_int, CGAL::Tag_true> {
+public:
+  struct Sgn : public CGAL::cpp98::unary_function<Type, ::CGAL::Sign> {
+    ::CGAL::Sign operator()(const Type& x) const { return x.sign(); }
+  };
+  struct To_double : public CGAL::cpp98::unary_function<Type, double> {
+    double operator()(const Type& x) const { return x.to_double(); }
+  };
+  struct Compare : public CGAL::cpp98::binary_function<Type, Type, Comparison_result> {
+    Comparison_result operator()(const Type& x, const Type& y) const { return (Comparison_result)compare(x, y); }
+  };
+  struct To_interval : public CGAL::cpp98::unary_function<Type, std::pair<double, double>> {
+    std::pair<double, double> operator()(const Type& x) const
+    {
+      // exact below 2^53; otherwise the interval of the Gmpz
+      const double d = x.to_double();
+      if (x.is_small() && d > -9007199254740992.0 && d < 9007199254740992.0) return { d, d };
+      return Real_embeddable_traits<Gmpz>::To_interval()(Gmpz(x));
+    }
+  };
+};
+
+CGAL_DEFINE_COERCION_TRAITS_FROM_TO(short, Small_int)
+CGAL_DEFINE_COERCION_TRAITS_FROM_TO(int, Small_int)
+CGAL_DEFINE_COERCION_TRAITS_FROM_TO(long, Small_int)
+
+} // namespace CGAL
+
+#endif
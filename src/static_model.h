@@ -0,0 +1,288 @@
+// Formulations written as constant data: the variables, rows and objective are
+// constexpr arrays, and the dense matrix CGAL reads is computed from them by the
+// compiler. Nothing is built at run time; program() hands the arrays to CGAL as
+// a Linear_program_from_iterators, row_names lists the row names, and
+// to_model() fills a Model for the tools that edit or inspect the program.
+//
+//   namespace f {
+//   enum Var { n, E, X, variables };
+//   constexpr const char* vname[] = { "#num_vertices", "#edges", "#crossings" };
+//   constexpr Static_row rows[] = {
+//     { "3n leq 2E", CGAL::SMALLER, { { n, 3 }, { E, -2 } }, 0 },
+//     { "E - X leq (15/7) (n - 2)", CGAL::SMALLER, { { E, 1 }, { X, -1 }, { n, -15, 7 } }, -30, 7 },
+//     ...
+//   };
+//   constexpr Static_term objective[] = { { E, -1 } };
+//   typedef Static_model<variables, vname, rows, objective> Formulation;
+//   }
+//
+// A row is written like a call of set_row(): terms (variable, numerator,
+// denominator) and the right-hand side, and it is scaled the same way (cleared
+// of denominators, divided by the gcd of its numerators). Instantiating
+// Static_model checks the description at compile time: one name per variable,
+// terms that name existing variables, no variable twice in a row, no empty
+// rows, no unused variables, distinct row names and coefficients that fit IT.
+// Variables have lower bound 0 and no upper bound, as in Model.
+#ifndef STATIC_MODEL_H
+#define STATIC_MODEL_H
+
+#include "lp_model.h"
+
+#include <array>
+#include <cstddef>
+
+// a term a_j x_j with a_j = num/den; col -1 marks an unused slot of a row
+struct Static_term {
+  int col = -1;
+  long long num = 0;
+  long long den = 1;
+};
+
+constexpr int static_row_terms = 24; // the most terms a row can have
+
+struct Static_row {
+  const char* name = nullptr;
+  CGAL::Comparison_result r = CGAL::EQUAL;
+  Static_term a[static_row_terms] = {};
+  long long b_num = 0;
+  long long b_den = 1;
+};
+
+namespace static_model {
+
+constexpr long long abs(long long x) { return x < 0 ? -x : x; }
+
+constexpr long long gcd(long long a, long long b)
+{
+  a = abs(a);
+  b = abs(b);
+  while (b != 0) {
+    const long long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+constexpr bool same(const char* s, const char* t)
+{
+  while (*s != '\0' && *s == *t) { ++s; ++t; }
+  return *s == *t;
+}
+
+constexpr int terms(const Static_row& row)
+{
+  int k = 0;
+  while (k < static_row_terms && row.a[k].col >= 0) ++k;
+  return k;
+}
+
+// the row as set_row() scales it: the coefficients (then b) times
+// den/g, where den clears the denominators and g is the gcd of the results
+struct Scale {
+  long long den = 1, g = 1;
+  constexpr long long operator()(long long num, long long d) const { return num * (den / d) / g; }
+};
+
+constexpr Scale scale(const Static_row& row)
+{
+  Scale s;
+  const int k = terms(row);
+  for (int t = 0; t < k; ++t) s.den = s.den / gcd(s.den, row.a[t].den) * row.a[t].den;
+  s.den = s.den / gcd(s.den, row.b_den) * row.b_den;
+  long long g = 0;
+  for (int t = 0; t < k; ++t) g = gcd(g, row.a[t].num * (s.den / row.a[t].den));
+  g = gcd(g, row.b_num * (s.den / row.b_den));
+  s.g = g == 0 ? 1 : g;
+  return s;
+}
+
+//// the checks
+template <std::size_t N> constexpr bool all_named(const char* const (&names)[N])
+{
+  for (std::size_t j = 0; j < N; ++j)
+    if (names[j] == nullptr) return false;
+  return true;
+}
+
+template <std::size_t M> constexpr bool columns_exist(const Static_row (&rows)[M], int variables)
+{
+  for (std::size_t i = 0; i < M; ++i)
+    for (int t = terms(rows[i]); t < static_row_terms; ++t)
+      if (rows[i].a[t].col != -1) return false; // a term after an unused slot
+  for (std::size_t i = 0; i < M; ++i)
+    for (int t = 0; t < terms(rows[i]); ++t)
+      if (rows[i].a[t].col >= variables) return false;
+  return true;
+}
+
+template <std::size_t M> constexpr bool no_repeated_terms(const Static_row (&rows)[M])
+{
+  for (std::size_t i = 0; i < M; ++i)
+    for (int s = 0; s < terms(rows[i]); ++s)
+      for (int t = s + 1; t < terms(rows[i]); ++t)
+        if (rows[i].a[s].col == rows[i].a[t].col) return false;
+  return true;
+}
+
+template <std::size_t M> constexpr bool no_empty_rows(const Static_row (&rows)[M])
+{
+  for (std::size_t i = 0; i < M; ++i) {
+    if (rows[i].name == nullptr || terms(rows[i]) == 0) return false;
+    bool nonzero = false;
+    for (int t = 0; t < terms(rows[i]); ++t) nonzero = nonzero || rows[i].a[t].num != 0;
+    if (!nonzero) return false;
+  }
+  return true;
+}
+
+template <std::size_t M> constexpr bool distinct_names(const Static_row (&rows)[M])
+{
+  for (std::size_t i = 0; i < M; ++i)
+    for (std::size_t k = i + 1; k < M; ++k)
+      if (same(rows[i].name, rows[k].name)) return false;
+  return true;
+}
+
+template <std::size_t M> constexpr bool positive_denominators(const Static_row (&rows)[M])
+{
+  for (std::size_t i = 0; i < M; ++i) {
+    if (rows[i].b_den <= 0) return false;
+    for (int t = 0; t < terms(rows[i]); ++t)
+      if (rows[i].a[t].den <= 0) return false;
+  }
+  return true;
+}
+
+constexpr bool fits(long long v) { return v >= -2147483647LL - 1 && v <= 2147483647LL; }
+
+template <std::size_t M> constexpr bool rows_fit(const Static_row (&rows)[M])
+{
+  for (std::size_t i = 0; i < M; ++i) {
+    const Scale s = scale(rows[i]);
+    if (!fits(s(rows[i].b_num, rows[i].b_den))) return false;
+    for (int t = 0; t < terms(rows[i]); ++t)
+      if (!fits(s(rows[i].a[t].num, rows[i].a[t].den))) return false;
+  }
+  return true;
+}
+
+template <std::size_t M, std::size_t K>
+constexpr bool every_variable_used(const Static_row (&rows)[M], const Static_term (&objective)[K], int variables)
+{
+  for (int j = 0; j < variables; ++j) {
+    bool used = false;
+    for (std::size_t i = 0; i < M; ++i)
+      for (int t = 0; t < terms(rows[i]); ++t) used = used || rows[i].a[t].col == j;
+    for (std::size_t t = 0; t < K; ++t) used = used || objective[t].col == j;
+    if (!used) return false;
+  }
+  return true;
+}
+
+template <std::size_t K> constexpr bool integral_objective(const Static_term (&objective)[K], int variables)
+{
+  for (std::size_t t = 0; t < K; ++t)
+    if (objective[t].col < 0 || objective[t].col >= variables || objective[t].den != 1 || !fits(objective[t].num))
+      return false;
+  return true;
+}
+
+// the index of the row with the given name, -1 if there is none
+template <std::size_t M> constexpr int row_index(const Static_row (&rows)[M], const char* name)
+{
+  for (std::size_t i = 0; i < M; ++i)
+    if (same(rows[i].name, name)) return (int)i;
+  return -1;
+}
+
+//// the program
+template <int N, int M> struct Matrix {
+  IT a[N][M] = {}; // column j, as CGAL reads A
+  IT b[M] = {};
+  CGAL::Comparison_result r[M] = {};
+  bool fl[N] = {};
+  IT l[N] = {};
+  bool fu[N] = {};
+  IT u[N] = {};
+  IT c[N] = {};
+};
+
+template <int N, int M, std::size_t K>
+constexpr Matrix<N, M> matrix(const Static_row (&rows)[M], const Static_term (&objective)[K])
+{
+  Matrix<N, M> x;
+  for (int i = 0; i < M; ++i) {
+    const Scale s = scale(rows[i]);
+    x.r[i] = rows[i].r;
+    x.b[i] = (IT)s(rows[i].b_num, rows[i].b_den);
+    for (int t = 0; t < terms(rows[i]); ++t) x.a[rows[i].a[t].col][i] = (IT)s(rows[i].a[t].num, rows[i].a[t].den);
+  }
+  for (int j = 0; j < N; ++j) x.fl[j] = true;
+  for (std::size_t t = 0; t < K; ++t) x.c[objective[t].col] = (IT)objective[t].num;
+  return x;
+}
+
+template <std::size_t M> constexpr std::array<const char*, M> names(const Static_row (&rows)[M])
+{
+  std::array<const char*, M> a = {};
+  for (std::size_t i = 0; i < M; ++i) a[i] = rows[i].name;
+  return a;
+}
+
+template <int N, int M> constexpr std::array<const IT*, N> columns(const Matrix<N, M>& x)
+{
+  std::array<const IT*, N> p = {};
+  for (int j = 0; j < N; ++j) p[j] = x.a[j];
+  return p;
+}
+
+} // namespace static_model
+
+template <int Variables, const auto& Names, const auto& Rows, const auto& Objective>
+struct Static_model {
+  static constexpr int n = (int)std::size(Names);
+  static constexpr int m = (int)std::size(Rows);
+
+  static_assert(n == Variables, "one name per variable");
+  static_assert(static_model::all_named(Names), "a variable has no name");
+  static_assert(static_model::columns_exist(Rows, Variables), "a term names a variable that does not exist");
+  static_assert(static_model::no_repeated_terms(Rows), "a variable appears twice in a row");
+  static_assert(static_model::no_empty_rows(Rows), "a row has no name or no nonzero term");
+  static_assert(static_model::distinct_names(Rows), "two rows have the same name");
+  static_assert(static_model::positive_denominators(Rows), "a coefficient has a denominator <= 0");
+  static_assert(static_model::rows_fit(Rows), "a scaled row coefficient does not fit IT");
+  static_assert(static_model::integral_objective(Objective, Variables), "the objective needs integers that fit IT");
+  static_assert(static_model::every_variable_used(Rows, Objective, Variables), "a variable is in no row");
+
+  static constexpr static_model::Matrix<n, m> matrix = static_model::matrix<n, m>(Rows, Objective);
+  static constexpr std::array<const IT*, n> columns = static_model::columns(matrix);
+  static constexpr std::array<const char*, m> row_names = static_model::names(Rows);
+
+  static Static_program program()
+  {
+    return Static_program(n, m, columns.data(), matrix.b, matrix.r, matrix.fl, matrix.l, matrix.fu, matrix.u, matrix.c);
+  }
+
+  // the same program as a Model (norm_row, density_row and factor as given)
+  static void to_model(Model& model, int norm_row, int density_row, double factor)
+  {
+    Program& lp = model.lp;
+    for (int j = 0; j < n; ++j) model.vname.push_back(Names[j]);
+    for (int i = 0; i < m; ++i) {
+      model.cname.push_back(Rows[i].name);
+      lp.set_r(i, matrix.r[i]);
+      lp.set_b(i, matrix.b[i]);
+    }
+    for (int j = 0; j < n; ++j) {
+      for (int i = 0; i < m; ++i)
+        if (matrix.a[j][i] != 0) lp.set_a(j, i, matrix.a[j][i]);
+      if (matrix.c[j] != 0) lp.set_c(j, matrix.c[j]);
+    }
+    model.norm_row = norm_row;
+    model.density_row = density_row;
+    model.factor = factor;
+  }
+};
+
+#endif
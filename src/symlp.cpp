@@ -0,0 +1,87 @@
+// Solves a formulation over the orbits of a symmetry group of its variables
+// (see symmetry.h) and expands the solution back to the full program.
+//
+//   symlp [--model basic|extended|no8|full] [--swap a:b[,c:d...]]... [--compare] [-v]
+//
+// The group is generated by the symmetries the builder registered in
+// Model::symmetry and one generator per --swap, a product of transpositions of
+// variables given by name, e.g.
+//   --swap "degree 4 vertex with cells 567t:degree 4 vertex with cells 576t"
+// The expanded point is checked exactly against every row; --compare also solves
+// the full program, -v prints the expanded values and multipliers.
+#include "symmetry.h"
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+  std::string preset = "basic";
+  std::vector<std::string> swaps;
+  bool compare = false, verbose = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--swap" && i + 1 < argc) swaps.push_back(argv[++i]);
+    else if (a == "--compare") compare = true;
+    else if (a == "-v") verbose = true;
+    else {
+      std::cerr << "usage: symlp [--model basic|extended|no8|full] [--swap a:b[,c:d...]]... [--compare] [-v]\n";
+      return 1;
+    }
+  }
+
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  for (const std::string& spec : swaps) {
+    std::vector<int> perm;
+    const std::string err = parse_swaps(m, spec, perm);
+    if (!err.empty()) {
+      std::cerr << "--swap " << spec << ": " << err << "\n";
+      return 1;
+    }
+    m.symmetry.push_back(perm);
+  }
+
+  Orbit_model om;
+  const std::string err = orbit_model(m, om);
+  if (!err.empty()) {
+    std::cout << "not a symmetry of " << preset << ", " << err << "\n";
+    return 2;
+  }
+  const Program& q = om.q.lp;
+  std::cout << m.symmetry.size() << " generators: " << m.lp.get_n() << " variables in " << q.get_n()
+            << " orbits, " << m.lp.get_m() << " rows in " << q.get_m() << " orbits\n";
+
+  Solution s = solve_lp(q);
+  if (s.is_unbounded()) { std::cout << "unbounded\n"; return 1; }
+  if (!s.is_optimal()) { std::cout << "infeasible\n"; return 1; }
+  const Expanded_solution e = expand(om, s);
+  const CGAL::Gmpq factor(om.q.factor);
+  std::cout << "|E| leq " << -e.objective / factor << "n (about " << -CGAL::to_double(s.objective_value()) / om.q.factor << ")\n";
+
+  const std::string bad = check_feasible(m, e.values);
+  std::cout << "expanded solution: " << (bad.empty() ? "feasible" : bad) << "\n";
+
+  if (compare) {
+    Solution full = solve_lp(m.lp);
+    if (!full.is_optimal()) std::cout << "full program: not optimal\n";
+    else {
+      const CGAL::Gmpq f(full.objective_value().numerator(), full.objective_value().denominator());
+      std::cout << "full program: |E| leq " << -f / factor << "n, " << (f == e.objective ? "same" : "DIFFERENT") << "\n";
+    }
+  }
+
+  if (verbose) {
+    std::cout << "\nvalues:\n";
+    for (std::size_t j = 0; j < e.values.size(); ++j)
+      std::cout << "  " << m.vname[j] << " = " << e.values[j] << "\n";
+    std::cout << "\nmultipliers (a row orbit's is split evenly over its rows):\n";
+    for (std::size_t i = 0; i < e.multipliers.size(); ++i)
+      if (e.multipliers[i] != 0)
+        std::cout << "  " << e.multipliers[i] << "\t" << (i < m.cname.size() ? m.cname[i] : "#" + std::to_string(i)) << "\n";
+  }
+  return bad.empty() ? 0 : 2;
+}
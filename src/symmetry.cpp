@@ -0,0 +1,209 @@
+#include "symmetry.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+
+namespace {
+
+typedef CGAL::Gmpq Q;
+
+// a row as sorted (variable, coefficient) pairs plus relation and right-hand side
+struct Row {
+  std::vector<std::pair<int, IT>> a;
+  int r;
+  IT b;
+  bool operator<(const Row& o) const { return std::tie(a, r, b) < std::tie(o.a, o.r, o.b); }
+};
+
+std::vector<Row> sparse_rows(const Program& lp)
+{
+  const int rows = lp.get_m(), cols = lp.get_n();
+  std::vector<Row> out(rows);
+  for (int j = 0; j < cols; ++j) {
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (col[i] != 0) out[i].a.push_back({j, col[i]});
+  }
+  for (int i = 0; i < rows; ++i) {
+    out[i].r = (int)lp.get_r()[i];
+    out[i].b = lp.get_b()[i];
+  }
+  return out;
+}
+
+struct Union_find {
+  std::vector<int> p;
+  explicit Union_find(int n) : p(n) { std::iota(p.begin(), p.end(), 0); }
+  int find(int v) { while (p[v] != v) v = p[v] = p[p[v]]; return v; }
+  void join(int a, int b) { a = find(a); b = find(b); if (a != b) p[std::max(a, b)] = std::min(a, b); }
+};
+
+// numbers the classes of uf by their smallest member
+std::vector<int> classes(Union_find& uf, int& count)
+{
+  std::vector<int> id(uf.p.size(), -1), out(uf.p.size());
+  count = 0;
+  for (std::size_t v = 0; v < uf.p.size(); ++v) {
+    const int r = uf.find((int)v);
+    if (id[r] < 0) id[r] = count++;
+    out[v] = id[r];
+  }
+  return out;
+}
+
+} // namespace
+
+std::string parse_swaps(const Model& m, const std::string& spec, std::vector<int>& perm)
+{
+  perm.resize(m.vname.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::istringstream in(spec);
+  std::string pair;
+  while (std::getline(in, pair, ',')) {
+    const std::size_t colon = pair.find(':');
+    if (colon == std::string::npos) return "expected name:name, got \"" + pair + "\"";
+    int v[2];
+    const std::string names[2] = { pair.substr(0, colon), pair.substr(colon + 1) };
+    for (int k = 0; k < 2; ++k) {
+      auto it = std::find(m.vname.begin(), m.vname.end(), names[k]);
+      if (it == m.vname.end()) return "no variable \"" + names[k] + "\"";
+      v[k] = (int)(it - m.vname.begin());
+    }
+    std::swap(perm[v[0]], perm[v[1]]);
+  }
+  return "";
+}
+
+std::string orbit_model(const Model& m, Orbit_model& out)
+{
+  const Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  const std::vector<Row> sparse = sparse_rows(lp);
+  auto name = [&](int j) { return j < (int)m.vname.size() ? m.vname[j] : "#" + std::to_string(j); };
+
+  // rows by content, to find the image of a row
+  std::map<Row, std::vector<int>> by_content;
+  for (int i = 0; i < rows; ++i) by_content[sparse[i]].push_back(i);
+
+  Union_find vars(cols), cons(rows);
+  for (std::size_t g = 0; g < m.symmetry.size(); ++g) {
+    const std::vector<int>& p = m.symmetry[g];
+    const std::string which = "generator " + std::to_string(g + 1) + ": ";
+    if ((int)p.size() != cols) return which + "not a permutation of the " + std::to_string(cols) + " variables";
+    std::vector<bool> hit(cols, false);
+    for (int j = 0; j < cols; ++j) {
+      if (p[j] < 0 || p[j] >= cols || hit[p[j]]) return which + "not a permutation";
+      hit[p[j]] = true;
+    }
+    for (int j = 0; j < cols; ++j) {
+      const int k = p[j];
+      if (lp.get_c()[j] != lp.get_c()[k])
+        return which + "objective differs on " + name(j) + " and " + name(k);
+      if (lp.get_fl()[j] != lp.get_fl()[k] || lp.get_fu()[j] != lp.get_fu()[k]
+          || (lp.get_fl()[j] && lp.get_l()[j] != lp.get_l()[k])
+          || (lp.get_fu()[j] && lp.get_u()[j] != lp.get_u()[k]))
+        return which + "bounds differ on " + name(j) + " and " + name(k);
+      vars.join(j, k);
+    }
+
+    // the image of each row; rows with equal content are matched in order
+    std::map<Row, std::size_t> used;
+    for (int i = 0; i < rows; ++i) {
+      Row img = sparse[i];
+      for (auto& e : img.a) e.first = p[e.first];
+      std::sort(img.a.begin(), img.a.end());
+      auto it = by_content.find(img);
+      if (it == by_content.end())
+        return which + "the image of row #" + std::to_string(i)
+             + (i < (int)m.cname.size() ? " \"" + m.cname[i] + "\"" : std::string()) + " is not a row";
+      cons.join(i, it->second[used[img]++ % it->second.size()]);
+    }
+  }
+
+  int nv, nr;
+  out.var_orbit = classes(vars, nv);
+  out.row_orbit = classes(cons, nr);
+  out.row_size.assign(nr, 0);
+  for (int i = 0; i < rows; ++i) ++out.row_size[out.row_orbit[i]];
+
+  // the quotient: coefficients of a representative row added up over each variable orbit
+  Model& q = out.q;
+  q = Model();
+  q.factor = m.factor;
+  q.vname.assign(nv, "");
+  std::vector<int> members(nv, 0);
+  for (int j = 0; j < cols; ++j) {
+    const int o = out.var_orbit[j];
+    if (members[o]++ == 0) {
+      q.vname[o] = name(j);
+      if (lp.get_fl()[j]) q.lp.set_l(o, true, lp.get_l()[j]);
+      else q.lp.set_l(o, false);
+      if (lp.get_fu()[j]) q.lp.set_u(o, true, lp.get_u()[j]);
+      else q.lp.set_u(o, false);
+    }
+    if (lp.get_c()[j] != 0) q.lp.set_c(o, q.lp.get_c()[o] + lp.get_c()[j]);
+  }
+  for (int o = 0; o < nv; ++o)
+    if (members[o] > 1) q.vname[o] += " (orbit of " + std::to_string(members[o]) + ")";
+  q.lp.set_c0(lp.get_c0());
+
+  std::vector<bool> done(nr, false);
+  for (int i = 0; i < rows; ++i) {
+    const int o = out.row_orbit[i];
+    if (done[o]) continue;
+    done[o] = true;
+    std::map<int, IT> a;
+    for (const auto& e : sparse[i].a) a[out.var_orbit[e.first]] += e.second;
+    for (const auto& e : a)
+      if (e.second != 0) q.lp.set_a(e.first, o, e.second);
+    q.lp.set_r(o, lp.get_r()[i]);
+    q.lp.set_b(o, lp.get_b()[i]);
+    q.cname.push_back((i < (int)m.cname.size() ? m.cname[i] : "#" + std::to_string(i))
+                      + (out.row_size[o] > 1 ? " (orbit of " + std::to_string(out.row_size[o]) + ")" : ""));
+  }
+  q.norm_row = m.norm_row < 0 ? -1 : out.row_orbit[m.norm_row];
+  q.density_row = m.density_row < 0 ? -1 : out.row_orbit[m.density_row];
+  return "";
+}
+
+Expanded_solution expand(const Orbit_model& om, const Solution& s)
+{
+  Expanded_solution e;
+  e.objective = Q(s.objective_value().numerator(), s.objective_value().denominator());
+  std::vector<Q> y, mu;
+  for (auto it = s.variable_values_begin(); it != s.variable_values_end(); ++it)
+    y.push_back(Q(it->numerator(), it->denominator()));
+  for (auto it = s.optimality_certificate_begin(); it != s.optimality_certificate_end(); ++it)
+    mu.push_back(Q(it->numerator(), it->denominator()));
+  for (int o : om.var_orbit) e.values.push_back(y[o]);
+  for (int o : om.row_orbit)
+    e.multipliers.push_back(o < (int)mu.size() ? mu[o] / Q(om.row_size[o]) : Q(0));
+  return e;
+}
+
+std::string check_feasible(const Model& m, const std::vector<Q>& x)
+{
+  const Program& lp = m.lp;
+  const int rows = lp.get_m(), cols = lp.get_n();
+  for (int j = 0; j < cols; ++j) {
+    if ((lp.get_fl()[j] && x[j] < Q(lp.get_l()[j])) || (lp.get_fu()[j] && x[j] > Q(lp.get_u()[j])))
+      return "variable " + m.vname[j] + " out of bounds";
+  }
+  std::vector<Q> ax(rows, Q(0));
+  for (int j = 0; j < cols; ++j) {
+    if (x[j] == 0) continue;
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (col[i] != 0) ax[i] += Q(col[i]) * x[j];
+  }
+  for (int i = 0; i < rows; ++i) {
+    const Q b(lp.get_b()[i]);
+    const CGAL::Comparison_result r = lp.get_r()[i];
+    if ((r == CGAL::EQUAL && ax[i] != b) || (r == CGAL::SMALLER && ax[i] > b) || (r == CGAL::LARGER && ax[i] < b))
+      return "row #" + std::to_string(i) + (i < (int)m.cname.size() ? " \"" + m.cname[i] + "\"" : std::string()) + " violated";
+  }
+  return "";
+}
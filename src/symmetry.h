@@ -0,0 +1,47 @@
+// Symmetry-orbit aggregation: the quotient of a formulation by a group of
+// permutations of its variables (Model::symmetry holds the generators).
+//
+// A generator must map the program to itself: it permutes the variables, and
+// the rows are permuted along (the image of every row, with its relation and
+// right-hand side, has to be a row again); objective and bounds are kept.
+// Averaging over the group then turns any optimal solution into one that is
+// constant on every variable orbit, so the LP over one variable per orbit and
+// one row per row orbit, with the coefficients of an orbit added up, has the
+// same optimum. Solutions expand back exactly: every variable takes the value
+// of its orbit, and the multiplier of a row orbit is split evenly over its rows.
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "lp_solve.h"
+
+#include <CGAL/Gmpq.h>
+#include <string>
+#include <vector>
+
+struct Orbit_model {
+  Model q;                    // one variable per variable orbit, one row per row orbit
+  std::vector<int> var_orbit; // quotient variable of each variable
+  std::vector<int> row_orbit; // quotient row of each row
+  std::vector<int> row_size;  // rows in each row orbit
+};
+
+// parses "a:b,c:d" (variable names) into a permutation of m's variables
+// that swaps a with b and c with d; returns an error message or ""
+std::string parse_swaps(const Model& m, const std::string& spec, std::vector<int>& perm);
+
+// builds the quotient of m by the group generated by m.symmetry; returns an
+// error message (a generator that is not a symmetry, and why) or ""
+std::string orbit_model(const Model& m, Orbit_model& out);
+
+// an optimal solution of the quotient, expanded to the variables and rows of m
+struct Expanded_solution {
+  CGAL::Gmpq objective;
+  std::vector<CGAL::Gmpq> values;      // one per variable of m
+  std::vector<CGAL::Gmpq> multipliers; // one per row of m
+};
+Expanded_solution expand(const Orbit_model& om, const Solution& s);
+
+// checks values against every row and bound of m, exactly; returns "" or the first violation
+std::string check_feasible(const Model& m, const std::vector<CGAL::Gmpq>& values);
+
+#endif
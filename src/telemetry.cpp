@@ -0,0 +1,214 @@
+#include "telemetry.h"
+
+#include <gmp.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+//// GMP allocations
+// Every GMP number lives in memory from these functions, so the largest
+// request bounds the bit length of every number seen while they are installed.
+void* (*gmp_alloc)(std::size_t);
+void* (*gmp_realloc)(void*, std::size_t, std::size_t);
+void (*gmp_free)(void*, std::size_t);
+std::atomic<std::size_t> gmp_max(0);
+
+void note(std::size_t bytes)
+{
+  std::size_t m = gmp_max.load(std::memory_order_relaxed);
+  while (bytes > m && !gmp_max.compare_exchange_weak(m, bytes, std::memory_order_relaxed)) {}
+}
+
+void* tracked_alloc(std::size_t bytes)
+{
+  note(bytes);
+  return gmp_alloc(bytes);
+}
+
+void* tracked_realloc(void* p, std::size_t old_bytes, std::size_t bytes)
+{
+  note(bytes);
+  return gmp_realloc(p, old_bytes, bytes);
+}
+
+void install()
+{
+  static std::once_flag once;
+  std::call_once(once, [] {
+    mp_get_memory_functions(&gmp_alloc, &gmp_realloc, &gmp_free);
+    mp_set_memory_functions(tracked_alloc, tracked_realloc, gmp_free);
+  });
+}
+
+std::size_t bits(const CGAL::Gmpz& x)
+{
+  return x == 0 ? 0 : mpz_sizeinbase(x.mpz(), 2);
+}
+
+// a JSON string (the names here never need more than quotes and backslashes)
+std::string quote(const std::string& s)
+{
+  std::string q = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') q += '\\';
+    q += c;
+  }
+  return q + "\"";
+}
+
+} // namespace
+
+long long peak_rss_kb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage u;
+  if (getrusage(RUSAGE_SELF, &u) != 0) return -1;
+#if defined(__APPLE__)
+  return u.ru_maxrss / 1024; // bytes
+#else
+  return u.ru_maxrss;
+#endif
+#else
+  return -1;
+#endif
+}
+
+Telemetry::Telemetry(const std::string& tool, const std::string& model)
+  : on(std::getenv("LP_TELEMETRY") != nullptr), tool(tool), name(model), start((long long)std::time(nullptr))
+{
+  if (on) install();
+}
+
+void Telemetry::begin(const char* p)
+{
+  if (!on) return;
+  end();
+  phase = p;
+  gmp_max.store(0);
+  since = std::chrono::steady_clock::now();
+}
+
+void Telemetry::end()
+{
+  if (!on || phase.empty()) return;
+  phases[phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+  gmp_bits[phase] = std::max(gmp_bits[phase], 8 * gmp_max.load());
+  phase.clear();
+}
+
+template <class P, class Name> void Telemetry::shape(const P& lp, Name vname)
+{
+  rows = lp.get_m();
+  columns = lp.get_n();
+  equal = smaller = larger = nonzeros = 0;
+  families.clear();
+  for (int i = 0; i < rows; ++i) {
+    const CGAL::Comparison_result r = lp.get_r()[i];
+    if (r == CGAL::EQUAL) ++equal;
+    else if (r == CGAL::SMALLER) ++smaller;
+    else ++larger;
+  }
+  for (int j = 0; j < columns; ++j) {
+    Family& f = families[family(vname(j))];
+    ++f.columns;
+    auto col = lp.get_a()[j];
+    for (int i = 0; i < rows; ++i)
+      if (col[i] != 0) { ++f.nonzeros; ++nonzeros; }
+  }
+}
+
+void Telemetry::model(const Model& m)
+{
+  if (!on) return;
+  shape(m.lp, [&](int j) { return j < (int)m.vname.size() ? m.vname[j] : std::string(); });
+}
+
+void Telemetry::model(const Static_program& lp, const char* const* vname)
+{
+  if (!on) return;
+  shape(lp, [&](int j) { return std::string(vname[j]); });
+}
+
+void Telemetry::solved(const Solution& s)
+{
+  if (!on) return;
+  std::size_t b = 0;
+  for (auto it = s.variable_values_begin(); it != s.variable_values_end(); ++it)
+    b = std::max(b, std::max(bits(it->numerator()), bits(it->denominator())));
+  if (s.is_optimal())
+    for (auto it = s.optimality_certificate_begin(); it != s.optimality_certificate_end(); ++it)
+      b = std::max(b, std::max(bits(it->numerator()), bits(it->denominator())));
+
+  std::lock_guard<std::mutex> g(lock);
+  ++solves;
+  pivots += s.number_of_iterations();
+  solution_bits = std::max(solution_bits, b);
+  ++status[s.is_optimal() ? "optimal" : s.is_infeasible() ? "infeasible" : s.is_unbounded() ? "unbounded" : "other"];
+}
+
+void Telemetry::count(const std::string& counter, long long by)
+{
+  if (!on) return;
+  std::lock_guard<std::mutex> g(lock);
+  counters[counter] += by;
+}
+
+void Telemetry::arena(const Gmp_arena_stats& s)
+{
+  if (!on) return;
+  // the arena serves requests the tracking hooks may never see
+  note(s.largest);
+  std::lock_guard<std::mutex> g(lock);
+  arenas.add(s);
+}
+
+Telemetry::~Telemetry()
+{
+  if (!on) return;
+  end();
+
+  std::ostringstream o;
+  o << "{\"tool\":" << quote(tool) << ",\"model\":" << quote(name) << ",\"start\":" << start;
+  o << ",\"phases\":{";
+  for (auto it = phases.begin(); it != phases.end(); ++it)
+    o << (it == phases.begin() ? "" : ",") << quote(it->first) << ":" << it->second;
+  o << "},\"rows\":" << rows << ",\"equal\":" << equal << ",\"smaller\":" << smaller
+    << ",\"larger\":" << larger << ",\"columns\":" << columns << ",\"nonzeros\":" << nonzeros;
+  o << ",\"families\":{";
+  for (auto it = families.begin(); it != families.end(); ++it)
+    o << (it == families.begin() ? "" : ",") << quote(it->first)
+      << ":{\"columns\":" << it->second.columns << ",\"nonzeros\":" << it->second.nonzeros << "}";
+  o << "},\"solves\":" << solves << ",\"pivots\":" << pivots << ",\"status\":{";
+  for (auto it = status.begin(); it != status.end(); ++it)
+    o << (it == status.begin() ? "" : ",") << quote(it->first) << ":" << it->second;
+  o << "},\"solution_bits\":" << solution_bits << ",\"gmp_bits\":{";
+  for (auto it = gmp_bits.begin(); it != gmp_bits.end(); ++it)
+    o << (it == gmp_bits.begin() ? "" : ",") << quote(it->first) << ":" << it->second;
+  o << "},\"peak_rss_kb\":" << peak_rss_kb();
+  if (arenas.sessions > 0)
+    o << ",\"gmp_arena\":{\"sessions\":" << arenas.sessions << ",\"allocations\":" << arenas.allocations
+      << ",\"reused\":" << arenas.reused << ",\"reallocations\":" << arenas.reallocations
+      << ",\"in_place\":" << arenas.in_place << ",\"frees\":" << arenas.frees << ",\"large\":" << arenas.large
+      << ",\"bytes\":" << arenas.bytes << ",\"chunk_bytes\":" << arenas.chunk_bytes << "}";
+  o << ",\"counters\":{";
+  for (auto it = counters.begin(); it != counters.end(); ++it)
+    o << (it == counters.begin() ? "" : ",") << quote(it->first) << ":" << it->second;
+  o << "}}\n";
+
+  const std::string path = std::getenv("LP_TELEMETRY");
+  if (path == "-" || path.empty()) std::cerr << o.str();
+  else {
+    std::ofstream out(path, std::ios::app);
+    if (out) out << o.str();
+    else std::cerr << "telemetry: cannot write " << path << "\n";
+  }
+}
@@ -0,0 +1,81 @@
+// Run telemetry: phase timings, model statistics, solver counters, GMP operand
+// sizes and peak RSS, written as one JSON line per run.
+//
+// Recording is off unless the environment variable LP_TELEMETRY names a file the
+// record is appended to ("-" for stderr); switched off, every call returns at once.
+// Switched on, the cost is a clock read per phase and a size comparison per GMP
+// allocation, so it can stay on in sweeps. The record looks like
+//   {"tool":"lp_solver","model":"basic","start":1700000000,
+//    "phases":{"build":0.0004,"solve":0.21,"check":0.0,"output":0.0001},
+//    "rows":36,"equal":20,"smaller":16,"larger":0,"columns":59,"nonzeros":301,
+//    "families":{"cells":{"columns":6,"nonzeros":40},...},
+//    "solves":1,"pivots":48,"status":{"optimal":1},"solution_bits":12,
+//    "gmp_bits":{"build":0,"solve":192,...},"peak_rss_kb":5120,"counters":{...}}
+// gmp_bits bounds the bit length of every GMP number in each phase (it is the
+// largest GMP allocation of the phase), solution_bits is the largest numerator
+// or denominator of the values and multipliers the solver returned. CGAL does not report its
+// phase-1 and phase-2 pivots separately, pivots is their sum. Tools that solve
+// in GMP arenas (gmp_arena.h) add "gmp_arena":{"sessions":..,"allocations":..,
+// "reused":..,...}, the sums of Gmp_arena_stats over all sessions.
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "gmp_arena.h"
+#include "lp_solve.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+class Telemetry {
+public:
+  Telemetry(const std::string& tool, const std::string& model);
+  ~Telemetry(); // writes the record
+  Telemetry(const Telemetry&) = delete;
+  Telemetry& operator=(const Telemetry&) = delete;
+
+  bool enabled() const { return on; }
+
+  // time from begin(name) to end() is added to phase name
+  void begin(const char* name);
+  void end();
+
+  // rows, columns and nonzeros of m, the columns split by family()
+  void model(const Model& m);
+  // the same for a program of constant arrays (static_model.h)
+  void model(const Static_program& lp, const char* const* vname);
+  // counts one solve (thread safe)
+  void solved(const Solution& s);
+  // adds to a named counter (thread safe)
+  void count(const std::string& name, long long by = 1);
+  // adds the statistics of GMP arenas (thread safe)
+  void arena(const Gmp_arena_stats& s);
+
+private:
+  struct Family { long long columns = 0, nonzeros = 0; };
+  template <class P, class Name> void shape(const P& lp, Name vname);
+
+  bool on;
+  std::string tool, name;
+  long long start;
+  std::map<std::string, double> phases;
+  std::map<std::string, std::size_t> gmp_bits;
+  std::string phase;
+  std::chrono::steady_clock::time_point since;
+
+  long long rows = 0, equal = 0, smaller = 0, larger = 0, columns = 0, nonzeros = 0;
+  std::map<std::string, Family> families;
+
+  std::mutex lock; // for the solve counters
+  long long solves = 0, pivots = 0;
+  std::size_t solution_bits = 0;
+  std::map<std::string, long long> status; // solves by outcome
+  std::map<std::string, long long> counters;
+  Gmp_arena_stats arenas;
+};
+
+// peak resident set size of the process in kB, -1 where unknown
+long long peak_rss_kb();
+
+#endif
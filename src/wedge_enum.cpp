@@ -0,0 +1,384 @@
+// Enumerates the wedge types around a crossing (the cyclic sequence of cell
+// sizes of the four cells meeting at the crossing) and which wedge types can
+// share a cell, by drawing each configuration locally and checking it for
+// 4-cycles. Prints the wedge variables and their incidence rows as a snippet
+// in the style of the mainMin_* formulations.
+//
+// usage: wedge_enum [--exclude AAAA:BBBB]... [cell sizes...]   (default: 5 6 7)
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <array>
+#include <bitset>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+// A cell at a crossing x between two consecutive endpoints u, v is the face
+// x - u - ... - v - x. The path from u to v is a sequence of steps:
+//   'P': a non-crossing edge (weight 2)
+//   'C': a pass through another crossing (weight 3)
+// and the cell size is 3 + sum of the weights, so c5 = P, c6 = C, c7 = PP,
+// c8 = CP or PC, and so on.
+const int MAXV = 128;
+typedef bitset<MAXV> Row;
+
+struct Local_graph {
+  vector<Row> adj;
+  vector<string> label;
+
+  int add_vertex(const string& name) {
+    if ((int)adj.size() >= MAXV) { cerr << "local drawing too large\n"; exit(1); }
+    adj.push_back(Row());
+    label.push_back(name);
+    return (int)adj.size() - 1;
+  }
+
+  void add_edge(int u, int v) {
+    adj[u].set(v);
+    adj[v].set(u);
+  }
+
+  // returns true and a witness if two vertices have two common neighbours
+  bool find_c4(array<int,4>& cyc) const {
+    int n = (int)adj.size();
+    for (int u = 0; u < n; ++u) {
+      for (int v = u + 1; v < n; ++v) {
+        Row common = adj[u] & adj[v];
+        if (common.count() < 2) continue;
+        int w1 = -1, w2 = -1;
+        for (int w = 0; w < n; ++w) {
+          if (!common.test(w)) continue;
+          if (w1 < 0) w1 = w; else { w2 = w; break; }
+        }
+        cyc = {u, w1, v, w2};
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// the second crossing met by a 'C' step: its four endpoints in cyclic order,
+// with the shared cell between the first two
+struct Pass {
+  array<int,4> ends;
+};
+
+vector<string> shapes_of_size(int s) {
+  vector<string> out;
+  // steps weigh 2 or 3, so a path has at most (s-3)/2 steps
+  for (int len = 1; 2 * len <= s - 3; ++len) {
+    for (int mask = 0; mask < (1 << len); ++mask) {
+      int w = 3;
+      string sh;
+      for (int k = 0; k < len; ++k) {
+        bool c = (mask >> k) & 1;
+        w += c ? 3 : 2;
+        sh.push_back(c ? 'C' : 'P');
+      }
+      if (w == s) out.push_back(sh);
+    }
+  }
+  return out;
+}
+
+int crossings_in_shape(const string& sh) {
+  return 1 + (int)count(sh.begin(), sh.end(), 'C');
+}
+
+// draws the cell path from u to v, creating fresh vertices on the way
+void draw_cell(Local_graph& g, int u, int v, const string& shape,
+               const string& tag, vector<Pass>* passes) {
+  int cur = u;
+  for (size_t k = 0; k < shape.size(); ++k) {
+    bool last = (k + 1 == shape.size());
+    int next = last ? v : g.add_vertex(tag + to_string(k));
+    if (shape[k] == 'P') {
+      g.add_edge(cur, next);
+    } else {
+      int cur_far = g.add_vertex(tag + to_string(k) + "'");
+      int next_far = g.add_vertex(tag + to_string(k) + "''");
+      g.add_edge(cur, cur_far);
+      g.add_edge(next, next_far);
+      if (passes) passes->push_back({{cur, next, cur_far, next_far}});
+    }
+    cur = next;
+  }
+}
+
+typedef array<int,4> Wedge; // cell sizes, cell i between endpoints i and i+1
+
+string wedge_name(const Wedge& w) {
+  string s;
+  for (int c : w) s += to_string(c);
+  return s;
+}
+
+// the 8 images of a wedge under rotation and reflection of the crossing
+vector<Wedge> dihedral_images(const Wedge& w) {
+  vector<Wedge> out;
+  for (int r = 0; r < 4; ++r) {
+    Wedge rot, ref;
+    for (int i = 0; i < 4; ++i) {
+      rot[i] = w[(r + i) % 4];
+      ref[i] = w[(r - i + 4) % 4];
+    }
+    out.push_back(rot);
+    out.push_back(ref);
+  }
+  return out;
+}
+
+Wedge canonical_wedge(const Wedge& w) {
+  vector<Wedge> im = dihedral_images(w);
+  return *min_element(im.begin(), im.end());
+}
+
+map<int, vector<string>> shapes;
+
+// draws crossing x with endpoints ends[0..3] (ends[0]-ends[2] and
+// ends[1]-ends[3] are the crossing edges); cell i gets shape choice[i],
+// except cell skip, which is already drawn
+void draw_wedge(Local_graph& g, const array<int,4>& ends,
+                const array<string,4>& choice, int skip, const string& tag,
+                vector<vector<Pass>>* passes) {
+  g.add_edge(ends[0], ends[2]);
+  g.add_edge(ends[1], ends[3]);
+  if (passes) passes->assign(4, vector<Pass>());
+  for (int i = 0; i < 4; ++i) {
+    if (i == skip) continue;
+    draw_cell(g, ends[i], ends[(i + 1) % 4], choice[i],
+              tag + string(1, 'a' + i) + string(1, 'a' + (i + 1) % 4) + ".",
+              passes ? &(*passes)[i] : nullptr);
+  }
+}
+
+// iterates over all shape choices for the cells of w, except cell skip
+template <class F>
+bool any_shape_choice(const Wedge& w, int skip, const string& fixed, F f) {
+  array<string,4> choice;
+  choice[skip < 0 ? 0 : skip] = fixed;
+  int idx[4] = {0, 0, 0, 0};
+  for (;;) {
+    for (int i = 0; i < 4; ++i) {
+      if (i != skip) choice[i] = shapes[w[i]][idx[i]];
+    }
+    if (f(choice)) return true;
+    int i = 0;
+    for (; i < 4; ++i) {
+      if (i == skip) continue;
+      if (++idx[i] < (int)shapes[w[i]].size()) break;
+      idx[i] = 0;
+    }
+    if (i == 4) return false;
+  }
+}
+
+struct Wedge_info {
+  Wedge w;
+  bool c4_free;
+  string witness;
+  vector<array<string,4>> drawings; // C4-free shape choices
+};
+
+Wedge_info analyse_wedge(const Wedge& w) {
+  Wedge_info info;
+  info.w = w;
+  info.c4_free = false;
+  any_shape_choice(w, -1, "", [&](const array<string,4>& choice) {
+    Local_graph g;
+    array<int,4> ends = {g.add_vertex("a"), g.add_vertex("b"),
+                         g.add_vertex("c"), g.add_vertex("d")};
+    draw_wedge(g, ends, choice, -1, "", nullptr);
+    array<int,4> cyc;
+    if (g.find_c4(cyc)) {
+      if (info.witness.empty()) {
+        info.witness = g.label[cyc[0]] + "-" + g.label[cyc[1]] + "-"
+                     + g.label[cyc[2]] + "-" + g.label[cyc[3]];
+      }
+    } else {
+      info.c4_free = true;
+      info.drawings.push_back(choice);
+    }
+    return false;
+  });
+  return info;
+}
+
+// can a cell of size s of wedge p be the same cell as a cell of wedge q
+// around the other crossing on that cell?
+bool can_share(const Wedge_info& p, const Wedge_info& q, int s) {
+  vector<Wedge> images = dihedral_images(q.w);
+  sort(images.begin(), images.end());
+  images.erase(unique(images.begin(), images.end()), images.end());
+
+  for (const auto& choice : p.drawings) {
+    for (int i = 0; i < 4; ++i) {
+      if (p.w[i] != s || crossings_in_shape(choice[i]) != 2) continue;
+
+      Local_graph g;
+      array<int,4> ends = {g.add_vertex("a"), g.add_vertex("b"),
+                           g.add_vertex("c"), g.add_vertex("d")};
+      vector<vector<Pass>> passes;
+      draw_wedge(g, ends, choice, -1, "", &passes);
+      const Pass& y = passes[i][0];
+
+      for (const Wedge& img : images) {
+        if (img[0] != s) continue;
+        // cell 0 of the image is the shared cell, already drawn from p's side
+        bool ok = any_shape_choice(img, 0, choice[i], [&](const array<string,4>& c2) {
+          Local_graph h = g;
+          draw_wedge(h, y.ends, c2, 0, "y", nullptr);
+          array<int,4> cyc;
+          return !h.find_c4(cyc);
+        });
+        if (ok) return true;
+      }
+    }
+  }
+  return false;
+}
+
+int main(int argc, char** argv) {
+  vector<int> sizes;
+  set<pair<string,string>> excluded;
+  for (int a = 1; a < argc; ++a) {
+    string arg = argv[a];
+    if (arg == "--exclude" && a + 1 < argc) {
+      string pr = argv[++a];
+      size_t colon = pr.find(':');
+      if (colon == string::npos) { cerr << "bad --exclude " << pr << "\n"; return 1; }
+      string x = pr.substr(0, colon), y = pr.substr(colon + 1);
+      excluded.insert({min(x, y), max(x, y)});
+    } else {
+      int s = atoi(arg.c_str());
+      if (s < 5) { cerr << "cell sizes start at 5\n"; return 1; }
+      sizes.push_back(s);
+    }
+  }
+  if (sizes.empty()) sizes = {5, 6, 7};
+  sort(sizes.begin(), sizes.end());
+  sizes.erase(unique(sizes.begin(), sizes.end()), sizes.end());
+
+  for (int s : sizes) shapes[s] = shapes_of_size(s);
+
+  // all wedges up to rotation/reflection
+  vector<Wedge_info> wedges;
+  int total = 0;
+  Wedge w;
+  int k = (int)sizes.size();
+  for (int code = 0; code < k * k * k * k; ++code) {
+    int c = code;
+    for (int i = 3; i >= 0; --i) { w[i] = sizes[c % k]; c /= k; }
+    if (canonical_wedge(w) != w) continue;
+    ++total;
+    wedges.push_back(analyse_wedge(w));
+  }
+
+  vector<Wedge_info> ok;
+  cout << "  //// Wedge types for cell sizes";
+  for (int s : sizes) cout << " " << s;
+  cout << " (generated by wedge_enum)\n";
+  cout << "  // " << total << " wedges up to symmetry, forbidden by a local C4:\n";
+  for (const auto& wi : wedges) {
+    if (wi.c4_free) ok.push_back(wi);
+    else cout << "  //   " << wedge_name(wi.w) << ": " << wi.witness << "\n";
+  }
+  for (const auto& wi : ok) {
+    cout << "  const int w_" << wedge_name(wi.w) << " = ++vvv; vname.push_back(\"wedge "
+         << wedge_name(wi.w) << "\");\n";
+  }
+
+  // cells with exactly two crossings are shared by two wedges
+  vector<int> shared;
+  for (int s : sizes) {
+    for (const string& sh : shapes[s]) {
+      if (crossings_in_shape(sh) == 2) { shared.push_back(s); break; }
+    }
+  }
+
+  for (int s : shared) {
+    string suffix = (s == 6) ? "" : "_c" + to_string(s);
+    vector<pair<int,int>> pairs;
+    cout << "\n  // wedge pairs sharing a c" << s << "\n";
+    for (size_t i = 0; i < ok.size(); ++i) {
+      if (count(ok[i].w.begin(), ok[i].w.end(), s) == 0) continue;
+      for (size_t j = i; j < ok.size(); ++j) {
+        if (count(ok[j].w.begin(), ok[j].w.end(), s) == 0) continue;
+        string x = wedge_name(ok[i].w), y = wedge_name(ok[j].w);
+        if (!can_share(ok[i], ok[j], s)) {
+          cout << "  //   " << x << " to " << y << ": C4 across the shared cell\n";
+          continue;
+        }
+        if (excluded.count({min(x, y), max(x, y)})) {
+          cout << "  //   " << x << " to " << y << ": excluded\n";
+          continue;
+        }
+        pairs.push_back({(int)i, (int)j});
+      }
+    }
+    for (const auto& pr : pairs) {
+      string x = wedge_name(ok[pr.first].w), y = wedge_name(ok[pr.second].w);
+      cout << "  const int w_" << x << "_" << y << suffix << " = ++vvv; vname.push_back(\"wedge "
+           << x << " to " << y << (suffix.empty() ? "" : " via c" + to_string(s)) << "\");\n";
+    }
+
+    // one wedge pair per shared cell
+    cout << "\n  ++ccc;\n";
+    cout << "  cname.push_back(\"sum of wedge pairs = c" << s << "\");\n";
+    cout << "  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);\n";
+    for (const auto& pr : pairs) {
+      cout << "  lp.set_a(w_" << wedge_name(ok[pr.first].w) << "_"
+           << wedge_name(ok[pr.second].w) << suffix << ", ccc, 1);\n";
+    }
+    cout << "  lp.set_a(c" << s << ", ccc, -1);\n";
+
+    // k w = sum_i w_{w i}, the diagonal pair counting twice
+    for (size_t i = 0; i < ok.size(); ++i) {
+      int mult = (int)count(ok[i].w.begin(), ok[i].w.end(), s);
+      if (mult == 0) continue;
+      string x = wedge_name(ok[i].w);
+      cout << "\n  ++ccc;\n";
+      cout << "  cname.push_back(\"" << mult << " w_" << x << " = sum_i w_{" << x << " i}\");\n";
+      cout << "  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);\n";
+      for (const auto& pr : pairs) {
+        if (pr.first != (int)i && pr.second != (int)i) continue;
+        int coef = (pr.first == pr.second) ? 2 : 1;
+        cout << "  lp.set_a(w_" << wedge_name(ok[pr.first].w) << "_"
+             << wedge_name(ok[pr.second].w) << suffix << ", ccc, " << coef << ");\n";
+      }
+      cout << "  lp.set_a(w_" << x << ", ccc, " << -mult << ");\n";
+    }
+  }
+
+  // cell incidences: every wedge is one crossing, and a cell of size s
+  // lies on as many crossings as its shape passes through
+  cout << "\n  ++ccc;\n";
+  cout << "  cname.push_back(\"sum of wedges = X\");\n";
+  cout << "  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);\n";
+  for (const auto& wi : ok) cout << "  lp.set_a(w_" << wedge_name(wi.w) << ", ccc, 1);\n";
+  cout << "  lp.set_a(X, ccc, -1);\n";
+  for (int s : sizes) {
+    set<int> per_cell;
+    for (const string& sh : shapes[s]) per_cell.insert(crossings_in_shape(sh));
+    if (per_cell.size() != 1) {
+      cout << "\n  // c" << s << " cells can lie on different numbers of crossings, no incidence row\n";
+      continue;
+    }
+    int x = *per_cell.begin();
+    cout << "\n  ++ccc;\n";
+    cout << "  cname.push_back(\"wedge cells = " << (x > 1 ? to_string(x) + " " : "") << "c" << s << "\");\n";
+    cout << "  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);\n";
+    for (const auto& wi : ok) {
+      int mult = (int)count(wi.w.begin(), wi.w.end(), s);
+      if (mult) cout << "  lp.set_a(w_" << wedge_name(wi.w) << ", ccc, " << mult << ");\n";
+    }
+    cout << "  lp.set_a(c" << s << ", ccc, " << -x << ");\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "wedge_pairs.h"
+
+#include <cassert>
+
+namespace {
+
+int index_of(const std::vector<Wedge_type>& types, const std::string& name)
+{
+  for (std::size_t i = 0; i < types.size(); ++i)
+    if (types[i].name == name) return (int)i;
+  return -1;
+}
+
+} // namespace
+
+int Wedge_pairs::pair(const std::string& a, const std::string& b) const
+{
+  const int i = index_of(types, a), j = index_of(types, b);
+  return (i < 0 || j < 0) ? -1 : var[i][j];
+}
+
+Wedge_pairs add_wedge_pairs(Model& m, int& vvv, const std::vector<Wedge_type>& types,
+                            const std::vector<std::pair<std::string, std::string>>& forbidden)
+{
+  const int k = (int)types.size();
+  Wedge_pairs wp;
+  wp.types = types;
+  wp.var.assign(k, std::vector<int>(k, -1));
+
+  std::vector<std::vector<bool>> allowed(k, std::vector<bool>(k, true));
+  for (const auto& f : forbidden) {
+    const int i = index_of(types, f.first), j = index_of(types, f.second);
+    assert(i >= 0 && j >= 0 && "forbidden pair of unknown wedge types");
+    allowed[i][j] = allowed[j][i] = false;
+  }
+
+  for (int i = 0; i < k; ++i) {
+    if (types[i].c6 == 0) continue;
+    for (int j = i; j < k; ++j) {
+      if (types[j].c6 == 0 || !allowed[i][j]) continue;
+      wp.var[i][j] = wp.var[j][i] = ++vvv;
+      m.vname.push_back("wedge " + types[i].name + " to " + types[j].name);
+    }
+  }
+  return wp;
+}
+
+void add_wedge_pair_rows(Model& m, int& ccc, const Wedge_pairs& wp, int c6)
+{
+  Program& lp = m.lp;
+  const int k = (int)wp.types.size();
+
+  // one c6-type per c6 cell
+  ++ccc;
+  m.cname.push_back("sum of wedge pairs = c6");
+  lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+  for (int i = 0; i < k; ++i)
+    for (int j = i; j < k; ++j)
+      if (wp.var[i][j] >= 0) lp.set_a(wp.var[i][j], ccc, 1);
+  lp.set_a(c6, ccc, -1);
+
+  // per wedge c6 constraints
+  for (int i = 0; i < k; ++i) {
+    const Wedge_type& w = wp.types[i];
+    if (w.c6 == 0) continue;
+    ++ccc;
+    m.cname.push_back((w.c6 > 1 ? std::to_string(w.c6) + " " : std::string())
+                      + "w_" + w.name + " = sum_i w_{" + w.name + " i}");
+    lp.set_r(ccc, CGAL::EQUAL); lp.set_b(ccc, 0);
+    for (int j = 0; j < k; ++j)
+      if (wp.var[i][j] >= 0) lp.set_a(wp.var[i][j], ccc, i == j ? 2 : 1);
+    lp.set_a(w.var, ccc, -w.c6);
+  }
+}
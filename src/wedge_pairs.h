@@ -0,0 +1,41 @@
+// Wedge pairs: the two crossings on the boundary of a c6 and their wedge types.
+// The pair variables and their incidence rows are generated from a table of
+// wedge types instead of being typed in, one variable per unordered pair of
+// types (a type paired with itself included) that can share a c6.
+#ifndef WEDGE_PAIRS_H
+#define WEDGE_PAIRS_H
+
+#include "lp_model.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// a wedge type: its variable, its cell sizes (e.g. "5566") and the number of
+// c6 cells around a crossing of this type
+struct Wedge_type {
+  int var;
+  std::string name;
+  int c6;
+};
+
+struct Wedge_pairs {
+  std::vector<Wedge_type> types;
+  std::vector<std::vector<int>> var; // var[i][j] = var[j][i], the pair variable or -1
+
+  // the variable of the pair of types a and b, -1 if there is none
+  int pair(const std::string& a, const std::string& b) const;
+};
+
+// adds the variables "wedge A to B" for all pairs of types with a c6 (A not after
+// B in the table), except the forbidden ones; the order only depends on the table
+Wedge_pairs add_wedge_pairs(Model& m, int& vvv, const std::vector<Wedge_type>& types,
+                            const std::vector<std::pair<std::string, std::string>>& forbidden);
+
+// adds the rows
+//   sum of all pairs = c6                 (each c6 has two crossings)
+//   k w = sum_i w_{w i}                   (for each type w with k c6 cells,
+//                                          the pair of w with itself counted twice)
+void add_wedge_pair_rows(Model& m, int& ccc, const Wedge_pairs& wp, int c6);
+
+#endif
@@ -0,0 +1,207 @@
+// Regression test and benchmark of one formulation:
+//   * the status and the exact bound must match the golden file,
+//   * the tight rows (nonzero multiplier) are diffed against the golden file,
+//   * the solve time and the peak memory must stay within a factor of the baseline.
+//
+//   regress --model basic|extended|no8|full [--golden dir] [--baseline file]
+//           [--tolerance 3] [--repeat 3] [--strict] [--update] [--presolve] [--scale]
+//
+// The golden file is <dir>/<model>.txt. A degenerate LP can have several optimal
+// multipliers, so a changed tight set is only reported unless --strict is given.
+// The baseline holds the time and peak RSS of an earlier run on the same machine;
+// without one (or with --update) the current run is written as the new baseline,
+// and time and memory are not checked in that run (it says so). Baselines are
+// not committed, they only mean something on the machine that wrote them.
+// --update also rewrites the golden file. --presolve solves with the implied
+// bounds of presolve.h set, --scale with the rows and columns scaled by
+// scaling.h; neither may change the status or the bound.
+// Exit code 1 on any failure.
+#include "lp_solve.h"
+#include "presolve.h"
+#include "scaling.h"
+#include "telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+struct Golden {
+  std::string status, bound;
+  std::vector<std::string> tight;
+};
+
+bool read_golden(const std::string& path, Golden& g)
+{
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    const std::size_t sp = line.find(' ');
+    const std::string key = line.substr(0, sp), value = sp == std::string::npos ? "" : line.substr(sp + 1);
+    if (key == "status") g.status = value;
+    else if (key == "bound") g.bound = value;
+    else if (key == "tight") g.tight.push_back(value);
+  }
+  return true;
+}
+
+void write_golden(const std::string& path, const std::string& model, const Golden& g)
+{
+  std::ofstream out(path);
+  out << "# golden values of the " << model << " formulation, written by regress --update\n"
+      << "status " << g.status << "\n"
+      << "bound " << g.bound << "\n";
+  for (const std::string& t : g.tight) out << "tight " << t << "\n";
+}
+
+std::string status_of(const Solution& s)
+{
+  return s.is_optimal() ? "optimal" : s.is_infeasible() ? "infeasible" : s.is_unbounded() ? "unbounded" : "other";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string preset, golden_dir = "tests/golden", baseline;
+  double tolerance = 3.0;
+  int repeat = 3;
+  bool strict = false, update = false, presolve = false, scale = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--model" && i + 1 < argc) preset = argv[++i];
+    else if (a == "--golden" && i + 1 < argc) golden_dir = argv[++i];
+    else if (a == "--baseline" && i + 1 < argc) baseline = argv[++i];
+    else if (a == "--tolerance" && i + 1 < argc) tolerance = std::atof(argv[++i]);
+    else if (a == "--repeat" && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--strict") strict = true;
+    else if (a == "--update") update = true;
+    else if (a == "--presolve") presolve = true;
+    else if (a == "--scale") scale = true;
+    else {
+      std::cerr << "usage: regress --model basic|extended|no8|full [--golden dir] [--baseline file]\n"
+                   "               [--tolerance 3] [--repeat 3] [--strict] [--update] [--presolve] [--scale]\n";
+      return 1;
+    }
+  }
+
+  Telemetry tel("regress", preset);
+  tel.begin("build");
+  Model m;
+  if (!build_model(preset, m)) {
+    std::cerr << "unknown model " << preset << " (basic, extended, no8, full)\n";
+    return 1;
+  }
+  tel.model(m);
+  if (presolve) {
+    tel.begin("presolve");
+    const Implied_bounds ib = implied_bounds(m);
+    if (!ib.infeasible.empty()) {
+      std::cout << "FAIL: presolve finds row \"" << ib.infeasible << "\" infeasible\n";
+      return 1;
+    }
+    tel.count("bounds_set", apply_bounds(m, ib));
+  }
+  if (scale) {
+    tel.begin("scale");
+    const Scaling sc = scale_model(m);
+    tel.count("rows_scaled", sc.rows_scaled);
+    tel.count("columns_scaled", sc.columns_scaled);
+  }
+
+  // the fastest of a few solves
+  tel.begin("solve");
+  Solution s;
+  double seconds = 0;
+  for (int r = 0; r < repeat; ++r) {
+    const auto t0 = std::chrono::steady_clock::now();
+    s = solve_lp(m.lp);
+    const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    seconds = r == 0 ? t : std::min(seconds, t);
+    tel.solved(s);
+  }
+  const long long rss = peak_rss_kb();
+  tel.begin("check");
+
+  Golden now;
+  now.status = status_of(s);
+  if (s.is_optimal()) {
+    const CGAL::Gmpq v(s.objective_value().numerator(), s.objective_value().denominator());
+    std::ostringstream b;
+    b << -v / CGAL::Gmpq(m.factor);
+    now.bound = b.str();
+    std::size_t i = 0;
+    for (auto it = s.optimality_certificate_begin(); it != s.optimality_certificate_end(); ++it, ++i)
+      if (*it != 0) now.tight.push_back(i < m.cname.size() ? m.cname[i] : "#" + std::to_string(i));
+  }
+  std::sort(now.tight.begin(), now.tight.end());
+  std::cout << preset << ": " << now.status << ", |E| leq " << now.bound << "n, "
+            << seconds << " s, " << rss << " kB\n";
+
+  int failures = 0;
+  const std::string golden_path = golden_dir + "/" + preset + ".txt";
+  Golden gold;
+  if (update) {
+    write_golden(golden_path, preset, now);
+    std::cout << "wrote " << golden_path << "\n";
+  }
+  else if (!read_golden(golden_path, gold)) {
+    std::cout << "FAIL: no golden file " << golden_path << " (run with --update)\n";
+    ++failures;
+  }
+  else {
+    if (gold.status != now.status) {
+      std::cout << "FAIL: status " << now.status << ", expected " << gold.status << "\n";
+      ++failures;
+    }
+    if (gold.bound != now.bound) {
+      std::cout << "FAIL: bound " << now.bound << ", expected " << gold.bound << "\n";
+      ++failures;
+    }
+    std::sort(gold.tight.begin(), gold.tight.end());
+    std::vector<std::string> gone, added;
+    std::set_difference(gold.tight.begin(), gold.tight.end(), now.tight.begin(), now.tight.end(), std::back_inserter(gone));
+    std::set_difference(now.tight.begin(), now.tight.end(), gold.tight.begin(), gold.tight.end(), std::back_inserter(added));
+    if (!gone.empty() || !added.empty()) {
+      std::cout << (strict ? "FAIL" : "note") << ": tight rows changed\n";
+      for (const std::string& t : gone) std::cout << "  - " << t << "\n";
+      for (const std::string& t : added) std::cout << "  + " << t << "\n";
+      if (strict) ++failures;
+    }
+  }
+
+  // time and memory; times under 0.1 s are compared as 0.1 s, below that it is noise
+  if (!baseline.empty()) {
+    double base_seconds = -1;
+    long long base_rss = -1;
+    std::ifstream in(baseline);
+    std::string key;
+    while (in >> key) {
+      if (key == "seconds") in >> base_seconds;
+      else if (key == "rss_kb") in >> base_rss;
+    }
+    if (update || base_seconds < 0) {
+      std::ofstream out(baseline);
+      out << "seconds " << seconds << "\nrss_kb " << rss << "\n";
+      std::cout << "note: " << (update ? "updated" : "no baseline yet, recorded") << " the baseline " << baseline
+                << "; time and memory were not compared in this run\n";
+    }
+    else {
+      if (std::max(seconds, 0.1) > tolerance * std::max(base_seconds, 0.1)) {
+        std::cout << "FAIL: solve took " << seconds << " s, baseline " << base_seconds << " s\n";
+        ++failures;
+      }
+      if (rss > 0 && base_rss > 0 && rss > tolerance * base_rss) {
+        std::cout << "FAIL: peak RSS " << rss << " kB, baseline " << base_rss << " kB\n";
+        ++failures;
+      }
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}